@@ -0,0 +1,153 @@
+#include "LoopExporter.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr int kWriteChunk = 65536;
+    // How long the audio thread may go without a block before a capture is given up.
+    constexpr auto kStallTimeout = std::chrono::seconds(2);
+
+    std::unique_ptr<juce::AudioFormat> makeFormat(const juce::File& file)
+    {
+        if (file.hasFileExtension("flac"))
+            return std::make_unique<juce::FlacAudioFormat>();
+        if (file.hasFileExtension("aif;aiff"))
+            return std::make_unique<juce::AiffAudioFormat>();
+        return std::make_unique<juce::WavAudioFormat>();
+    }
+}
+
+LoopExporter::LoopExporter(LoopSnapshot& snapshotToWrite)
+    : snapshot(snapshotToWrite)
+{
+    worker = std::thread([this] { run(); });
+}
+
+LoopExporter::~LoopExporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+
+    wake.notify_one();
+    worker.join();
+}
+
+bool LoopExporter::isBusy() const
+{
+    const auto current = status.load();
+    return current == Status::Capturing || current == Status::Writing;
+}
+
+bool LoopExporter::start(const juce::File& file, int channels, int maxFrames)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (hasJob || !snapshot.request(channels, maxFrames))
+            return false;
+
+        target = file;
+        hasJob = true;
+        status.store(Status::Capturing);
+    }
+
+    wake.notify_one();
+    return true;
+}
+
+void LoopExporter::run()
+{
+    for (;;)
+    {
+        juce::File file;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return hasJob || quit; });
+            if (quit)
+                return;
+
+            file = target;
+        }
+
+        // The audio thread cannot signal, so the copy is polled; it finishes within a few blocks.
+        // A host that stops calling processBlock (bypass, or a stopped transport in some hosts)
+        // would leave it waiting forever, so a capture that sees no block for a while is
+        // cancelled and reported as interrupted straight away. The copy itself is released once
+        // the audio thread has let go of it.
+        auto state = snapshot.getState();
+        auto advances = snapshot.getAdvanceCount();
+        auto lastAdvance = std::chrono::steady_clock::now();
+        auto cancelled = false;
+        for (; state == LoopSnapshot::State::Requested || state == LoopSnapshot::State::Copying;
+             state = snapshot.getState())
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (wake.wait_for(lock, std::chrono::milliseconds(5), [this] { return quit; }))
+                    return;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (snapshot.getAdvanceCount() != advances)
+            {
+                advances = snapshot.getAdvanceCount();
+                lastAdvance = now;
+            }
+            else if (!cancelled && now - lastAdvance > kStallTimeout)
+            {
+                cancelled = true;
+                snapshot.cancel();
+                status.store(Status::Interrupted);
+            }
+        }
+
+        // A cancelled export has already been reported; a copy that completed after all is dropped.
+        if (!cancelled && state == LoopSnapshot::State::Complete)
+        {
+            status.store(Status::Writing);
+            status.store(write(file) ? Status::Done : Status::WriteFailed);
+        }
+        else if (!cancelled)
+        {
+            status.store(state == LoopSnapshot::State::Abandoned ? Status::Interrupted : Status::NoLoop);
+        }
+
+        snapshot.release();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        hasJob = false;
+    }
+}
+
+bool LoopExporter::write(const juce::File& file)
+{
+    const auto numChannels = snapshot.getNumChannels();
+    const auto length = snapshot.getLength();
+    const auto format = makeFormat(file);
+
+    file.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream(file.createOutputStream());
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        stream != nullptr ? format->createWriterFor(stream.get(), snapshot.getSampleRate(),
+                                                    static_cast<unsigned int>(numChannels), 24, {}, 0)
+                          : nullptr);
+    if (writer == nullptr)
+        return false;
+    stream.release();
+
+    std::vector<const float*> channels(static_cast<size_t>(numChannels));
+    for (int offset = 0; offset < length; offset += kWriteChunk)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            channels[static_cast<size_t>(channel)] = snapshot.getChannel(channel) + offset;
+
+        if (!writer->writeFromFloatArrays(channels.data(), numChannels, juce::jmin(kWriteChunk, length - offset)))
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "dsp/LoopSnapshot.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Writes the loop to an audio file in the background. start() asks the audio thread for a
+// LoopSnapshot; the worker waits for the copy to complete, then writes it out as 24-bit WAV,
+// FLAC or AIFF (picked by the file extension) without touching the engine again.
+class LoopExporter
+{
+public:
+    enum class Status
+    {
+        Idle,
+        Capturing,
+        Writing,
+        Done,
+        NoLoop,
+        Interrupted,
+        WriteFailed
+    };
+
+    explicit LoopExporter(LoopSnapshot& snapshotToWrite);
+    ~LoopExporter();
+
+    // Message thread. `maxFrames` bounds the loop length; false while an export is running.
+    bool start(const juce::File& file, int channels, int maxFrames);
+
+    Status getStatus() const { return status.load(); }
+    bool isBusy() const;
+
+private:
+    void run();
+    bool write(const juce::File& file);
+
+    LoopSnapshot& snapshot;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    juce::File target;
+    bool hasJob = false;
+    bool quit = false;
+    std::atomic<Status> status { Status::Idle };
+};
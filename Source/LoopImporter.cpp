@@ -0,0 +1,140 @@
+#include "LoopImporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+LoopImporter::LoopImporter(LoopImportStream& streamToFill)
+    : stream(streamToFill)
+{
+    worker = std::thread([this] { run(); });
+}
+
+LoopImporter::~LoopImporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+
+    wake.notify_one();
+    worker.join();
+}
+
+bool LoopImporter::canRead(const juce::File& file)
+{
+    return file.hasFileExtension("wav;aif;aiff;flac;ogg;mp3");
+}
+
+bool LoopImporter::start(const juce::File& file, int channels, int maxFrames, double sampleRate)
+{
+    if (channels <= 0 || maxFrames <= 0 || sampleRate <= 0.0)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (hasJob)
+            return false;
+
+        job = { file, channels, maxFrames, sampleRate };
+        hasJob = true;
+        status.store(Status::Loading);
+    }
+
+    wake.notify_one();
+    return true;
+}
+
+void LoopImporter::run()
+{
+    for (;;)
+    {
+        Job current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return hasJob || quit; });
+            if (quit)
+                return;
+
+            current = job;
+        }
+
+        const auto result = load(current);
+        const auto state = stream.getState();
+        if (state == LoopImportStream::State::Complete || state == LoopImportStream::State::Cancelled)
+            stream.close();
+        status.store(result);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        hasJob = false;
+        if (quit)
+            return;
+    }
+}
+
+LoopImporter::Status LoopImporter::load(const Job& current)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(current.file));
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->numChannels == 0)
+        return Status::Unreadable;
+
+    // Whatever fits in memory after conversion becomes the loop.
+    const auto ratio = current.sampleRate / reader->sampleRate;
+    const auto sourceLength = static_cast<int>(std::min<juce::int64>(
+        reader->lengthInSamples, static_cast<juce::int64>(std::floor(current.maxFrames / ratio))));
+    const auto length = std::min(current.maxFrames, static_cast<int>(std::lround(sourceLength * ratio)));
+    if (sourceLength <= 0 || length <= 0)
+        return Status::Unreadable;
+
+    juce::AudioBuffer<float> source(static_cast<int>(reader->numChannels), sourceLength);
+    if (!reader->read(&source, 0, sourceLength, 0, true, true))
+        return Status::Unreadable;
+
+    const auto resample = std::abs(ratio - 1.0) > 1.0e-9;
+    if (resample)
+        converter.prepare(ratio);
+
+    // Opened only now, so the engine keeps running until there is audio to stream.
+    if (!stream.begin(current.channels, length, current.sampleRate))
+        return Status::Interrupted;
+
+    constexpr auto pageSize = LoopImportStream::pageSize;
+    for (int offset = 0; offset < length; offset += pageSize)
+    {
+        float* slot = nullptr;
+        while ((slot = stream.acquire()) == nullptr)
+        {
+            if (stream.getState() == LoopImportStream::State::Cancelled || !pause())
+                return Status::Interrupted;
+        }
+
+        const auto frames = std::min(pageSize, length - offset);
+        for (int channel = 0; channel < current.channels; ++channel)
+        {
+            // Mono files feed every channel.
+            const auto* input = source.getReadPointer(std::min(channel, source.getNumChannels() - 1));
+            auto* page = slot + channel * pageSize;
+            if (resample)
+                converter.process(input, sourceLength, page, length, offset, frames);
+            else
+                std::copy(input + offset, input + offset + frames, page);
+        }
+
+        stream.publish(frames);
+    }
+
+    for (auto state = stream.getState(); state == LoopImportStream::State::Streaming; state = stream.getState())
+        if (!pause())
+            return Status::Interrupted;
+
+    return stream.getState() == LoopImportStream::State::Complete ? Status::Done : Status::Interrupted;
+}
+
+bool LoopImporter::pause()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    return !wake.wait_for(lock, std::chrono::milliseconds(2), [this] { return quit; });
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "dsp/LoopImportStream.h"
+#include "dsp/RateConverter.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Loads an audio file as the loop in the background. The worker decodes the file, converts it to
+// the engine's sample rate as one seamless cycle (cut to the memory's length), and streams the
+// result page by page through a LoopImportStream for the audio thread to write into memory.
+class LoopImporter
+{
+public:
+    enum class Status
+    {
+        Idle,
+        Loading,
+        Done,
+        Unreadable,
+        Interrupted
+    };
+
+    explicit LoopImporter(LoopImportStream& streamToFill);
+    ~LoopImporter();
+
+    // Message thread. Loads `file` for memory of `channels` x `maxFrames` at `sampleRate`; false
+    // while an import is running.
+    bool start(const juce::File& file, int channels, int maxFrames, double sampleRate);
+
+    Status getStatus() const { return status.load(); }
+
+    // Extensions of the formats start() can read, for drag-and-drop filtering.
+    static bool canRead(const juce::File& file);
+
+private:
+    struct Job
+    {
+        juce::File file;
+        int channels = 0;
+        int maxFrames = 0;
+        double sampleRate = 0.0;
+    };
+
+    void run();
+    Status load(const Job& job);
+    // Sleeps briefly; false once the importer is shutting down.
+    bool pause();
+
+    LoopImportStream& stream;
+    RateConverter converter;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    Job job;
+    bool hasJob = false;
+    bool quit = false;
+    std::atomic<Status> status { Status::Idle };
+};
@@ -0,0 +1,97 @@
+#include "LoopStatusComponent.h"
+
+namespace
+{
+    constexpr float kLedWidth = 54.0f;
+    constexpr float kLedGap = 6.0f;
+    constexpr float kTimeWidth = 110.0f;
+}
+
+void LoopStatusComponent::setStatus(const EngineStatus& newStatus)
+{
+    const auto changed = newStatus.state != status.state || newStatus.clip != status.clip
+                         || newStatus.playhead != status.playhead || newStatus.loopLength != status.loopLength
+                         || newStatus.recordedSamples != status.recordedSamples;
+    status = newStatus;
+    if (changed)
+        repaint();
+}
+
+void LoopStatusComponent::paint(juce::Graphics& g)
+{
+    auto area = getLocalBounds().toFloat();
+
+    g.setColour(juce::Colour::fromRGBA(15, 20, 32, 210));
+    g.fillRoundedRectangle(area, 10.0f);
+    g.setColour(juce::Colour::fromRGBA(110, 160, 190, 60));
+    g.drawRoundedRectangle(area.reduced(0.5f), 10.0f, 1.0f);
+
+    area.reduce(10.0f, 7.0f);
+    const auto led = [&area]
+    {
+        auto bounds = area.removeFromLeft(kLedWidth);
+        area.removeFromLeft(kLedGap);
+        return bounds;
+    };
+
+    drawLed(g, led(), "REC", juce::Colour::fromRGB(255, 80, 80), status.state == LoopState::Record);
+    drawLed(g, led(), "PLAY", juce::Colour::fromRGB(90, 230, 140), status.state == LoopState::Play);
+    drawLed(g, led(), "DUB", juce::Colour::fromRGB(255, 190, 70), status.state == LoopState::Overdub);
+    drawLed(g, area.removeFromRight(kLedWidth), "CLIP", juce::Colour::fromRGB(255, 60, 60), status.clip);
+    area.removeFromRight(kLedGap);
+
+    const auto recording = status.state == LoopState::Record;
+    const auto hasLoop = status.loopLength > 0;
+    auto timeArea = area.removeFromRight(kTimeWidth);
+    area.removeFromLeft(4.0f);
+    area.removeFromRight(kLedGap);
+
+    g.setColour(juce::Colour::fromRGB(45, 70, 90));
+    g.fillRoundedRectangle(area, 4.0f);
+
+    juce::String timeText("no loop");
+    if (recording)
+    {
+        g.setColour(juce::Colour::fromRGB(255, 80, 80).withAlpha(0.7f));
+        g.fillRoundedRectangle(area.withWidth(area.getWidth() * status.getRecordProgress()), 4.0f);
+        timeText = formatSeconds(status.recordedSamples) + " / " + formatSeconds(status.capacitySamples);
+    }
+    else if (hasLoop)
+    {
+        const auto x = area.getX() + area.getWidth() * status.getLoopProgress();
+        g.setColour(juce::Colour::fromRGB(90, 226, 255).withAlpha(0.25f));
+        g.fillRoundedRectangle(area.withRight(x), 4.0f);
+        g.setColour(juce::Colour::fromRGB(122, 248, 255));
+        g.fillRect(juce::Rectangle<float>(x - 1.0f, area.getY(), 2.0f, area.getHeight()));
+        timeText = formatSeconds(status.playhead) + " / " + formatSeconds(status.loopLength);
+    }
+
+    g.setColour(juce::Colour::fromRGB(195, 205, 220));
+    g.setFont(juce::Font(12.0f));
+    g.drawText(timeText, timeArea, juce::Justification::centredRight);
+}
+
+void LoopStatusComponent::drawLed(juce::Graphics& g, juce::Rectangle<float> bounds, const juce::String& text,
+                                  juce::Colour colour, bool lit)
+{
+    const auto dot = bounds.removeFromLeft(bounds.getHeight()).reduced(5.0f);
+    g.setColour(lit ? colour : colour.withAlpha(0.18f));
+    g.fillEllipse(dot);
+    if (lit)
+    {
+        g.setColour(colour.withAlpha(0.35f));
+        g.drawEllipse(dot.expanded(2.0f), 2.0f);
+    }
+
+    g.setColour(lit ? juce::Colour::fromRGB(230, 235, 245) : juce::Colour::fromRGB(120, 135, 155));
+    g.setFont(juce::Font(11.0f, juce::Font::bold));
+    g.drawText(text, bounds, juce::Justification::centredLeft);
+}
+
+juce::String LoopStatusComponent::formatSeconds(double samples) const
+{
+    if (status.sampleRate <= 0.0)
+        return "-";
+
+    return juce::String(samples / status.sampleRate, 2) + " s";
+}
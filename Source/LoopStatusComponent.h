@@ -0,0 +1,21 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "dsp/EngineStatus.h"
+
+// Record/Play/Overdub LEDs driven by the engine's actual loop state, a clip LED, and a strip
+// showing the playhead inside the loop (or how much of the buffer a recording has used).
+class LoopStatusComponent final : public juce::Component
+{
+public:
+    void setStatus(const EngineStatus& newStatus);
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    void drawLed(juce::Graphics& g, juce::Rectangle<float> bounds, const juce::String& text,
+                 juce::Colour colour, bool lit);
+    juce::String formatSeconds(double samples) const;
+
+    EngineStatus status;
+};
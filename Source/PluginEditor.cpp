@@ -5,14 +5,28 @@ namespace
     constexpr int kSliderWidth = 80;
     constexpr int kSliderHeight = 170;
     constexpr int kSliderGap = 6;
-    constexpr int kSliderCount = 9;
+    constexpr int kSliderCount = 11;
     constexpr int kLeftColumnWidth = 210;
     constexpr int kRightPanelWidth = 120;
     constexpr int kMeterWidth = 34;
     constexpr int kMargin = 16;
     constexpr int kHeaderHeight = 56;
+    constexpr int kStatusGap = 30;
+    constexpr int kStatusHeight = 34;
     constexpr bool kAnimateWaves = true;
 
+    juce::String describeBinding(const FootswitchBinding& binding)
+    {
+        if (binding.kind == FootswitchBinding::Kind::None)
+            return "unassigned";
+
+        auto text = juce::String(binding.kind == FootswitchBinding::Kind::Note ? "Note " : "CC ")
+                    + juce::String(binding.number);
+        if (binding.channel > 0)
+            text += " ch " + juce::String(binding.channel);
+        return text;
+    }
+
     void configureSlider(juce::Slider& slider)
     {
         slider.setSliderStyle(juce::Slider::LinearVertical);
@@ -88,6 +102,16 @@ SixteenSecondAudioProcessorEditor::SixteenSecondAudioProcessorEditor(SixteenSeco
     filterAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         processor.getAPVTS(), "filter", filterSlider);
 
+    configureSlider(resonanceSlider);
+    resonanceSlider.setRange(0.0, 1.0, 0.001);
+    resonanceLabel.setText("Resonance", juce::dontSendNotification);
+    resonanceLabel.setJustificationType(juce::Justification::centred);
+    resonanceLabel.attachToComponent(&resonanceSlider, false);
+    addAndMakeVisible(resonanceSlider);
+    addAndMakeVisible(resonanceLabel);
+    resonanceAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        processor.getAPVTS(), "resonance", resonanceSlider);
+
     configureSlider(noiseSlider);
     noiseSlider.setRange(0.0, 1.0, 0.001);
     noiseLabel.setText("Noise", juce::dontSendNotification);
@@ -118,6 +142,16 @@ SixteenSecondAudioProcessorEditor::SixteenSecondAudioProcessorEditor(SixteenSeco
     modSpeedAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
         processor.getAPVTS(), "modSpeed", modSpeedSlider);
 
+    configureSlider(speedSlider);
+    speedSlider.setRange(0.25, 2.0, 0.001);
+    speedLabel.setText("Speed", juce::dontSendNotification);
+    speedLabel.setJustificationType(juce::Justification::centred);
+    speedLabel.attachToComponent(&speedSlider, false);
+    addAndMakeVisible(speedSlider);
+    addAndMakeVisible(speedLabel);
+    speedAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        processor.getAPVTS(), "speed", speedSlider);
+
     configureSlider(outputGainSlider);
     outputGainSlider.setRange(-24.0, 12.0, 0.01);
 
@@ -174,6 +208,61 @@ SixteenSecondAudioProcessorEditor::SixteenSecondAudioProcessorEditor(SixteenSeco
     limiterAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         processor.getAPVTS(), "limiter", limiterButton);
 
+    hqPlaybackButton.setButtonText("HQ");
+    hqPlaybackButton.setTooltip("Band-limited (sinc) loop playback in SAFE-ish mode; off uses linear reads");
+    addAndMakeVisible(hqPlaybackButton);
+
+    hqPlaybackAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        processor.getAPVTS(), "hqPlayback", hqPlaybackButton);
+
+    cleanCaptureButton.setButtonText("Clean");
+    cleanCaptureButton.setTooltip("Record without the filter/grit degradation (straight copy into the loop)");
+    addAndMakeVisible(cleanCaptureButton);
+
+    cleanCaptureAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        processor.getAPVTS(), "cleanCapture", cleanCaptureButton);
+
+    storageBox.addItemList({ "32-bit float", "16-bit", "12-bit" }, 1);
+    storageBox.setTooltip("Loop memory format: 16/12-bit halve the footprint and clip at full scale");
+    addAndMakeVisible(storageBox);
+
+    storageAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processor.getAPVTS(), "storage", storageBox);
+
+    filterModeBox.addItemList({ "Lowpass", "Bandpass", "Highpass" }, 1);
+    filterModeBox.setTooltip("Response of the feedback tone filter that Filter and Resonance shape");
+    addAndMakeVisible(filterModeBox);
+
+    filterModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processor.getAPVTS(), "filterMode", filterModeBox);
+
+    watchdogLabel.setJustificationType(juce::Justification::centredRight);
+    watchdogLabel.setFont(juce::Font(12.0f));
+    addAndMakeVisible(watchdogLabel);
+
+    traceButton.setButtonText("Trace");
+    traceButton.setTooltip("Dump the recent engine event trace to a text file in Documents");
+    traceButton.onClick = [this]
+    {
+        const auto file = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                              .getChildFile("16-Second Trace.txt");
+        if (processor.writeEventTrace(file))
+            file.revealToUser();
+    };
+    addAndMakeVisible(traceButton);
+
+    exportButton.setButtonText("Export");
+    exportButton.setTooltip("Save the loop as a WAV, FLAC or AIFF file (playback carries on)");
+    exportButton.onClick = [this] { chooseExportFile(); };
+    addAndMakeVisible(exportButton);
+
+    midiButton.setButtonText("MIDI");
+    midiButton.setTooltip("Footswitch mappings and MIDI learn");
+    midiButton.onClick = [this] { showMidiMenu(); };
+    addAndMakeVisible(midiButton);
+
+    addAndMakeVisible(loopStatus);
+
     const int totalSliderWidth = kSliderWidth * kSliderCount + kSliderGap * (kSliderCount - 1);
     const int totalWidth = kLeftColumnWidth + totalSliderWidth + kRightPanelWidth + kMargin * 2;
     setSize(totalWidth, 360);
@@ -190,10 +279,32 @@ void SixteenSecondAudioProcessorEditor::paint(juce::Graphics& g)
     juce::ignoreUnused(g);
 }
 
+void SixteenSecondAudioProcessorEditor::paintOverChildren(juce::Graphics& g)
+{
+    if (!fileDragOver)
+        return;
+
+    g.setColour(juce::Colour::fromRGBA(90, 226, 255, 40));
+    g.fillRoundedRectangle(getLocalBounds().toFloat().reduced(4.0f), 18.0f);
+    g.setColour(juce::Colour::fromRGB(122, 248, 255));
+    g.drawRoundedRectangle(getLocalBounds().toFloat().reduced(4.0f), 18.0f, 2.0f);
+}
+
 void SixteenSecondAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds().reduced(kMargin);
     auto header = area.removeFromTop(kHeaderHeight);
+    auto headerControls = header.reduced(16, 12);
+    exportButton.setBounds(headerControls.removeFromRight(72));
+    headerControls.removeFromRight(6);
+    traceButton.setBounds(headerControls.removeFromRight(64));
+    headerControls.removeFromRight(6);
+    midiButton.setBounds(headerControls.removeFromRight(64));
+    headerControls.removeFromRight(6);
+    storageBox.setBounds(headerControls.removeFromRight(110));
+    headerControls.removeFromRight(6);
+    filterModeBox.setBounds(headerControls.removeFromRight(100));
+    watchdogLabel.setBounds(headerControls.removeFromRight(260));
 
     auto leftColumn = area.removeFromLeft(kLeftColumnWidth);
     auto topRow = area.removeFromTop(kSliderHeight);
@@ -215,48 +326,171 @@ void SixteenSecondAudioProcessorEditor::resized()
     addSlider(modDepthSlider);
     addSlider(modSpeedSlider);
     addSlider(filterSlider);
+    addSlider(resonanceSlider);
     addSlider(noiseSlider);
     addSlider(overdubLevelSlider);
     addSlider(erodeAmountSlider);
+    addSlider(speedSlider);
 
     auto outputArea = rightPanelArea.reduced(16, 14);
     outputGainSlider.setBounds(outputArea);
 
-    auto buttonArea = leftColumn.removeFromTop(200);
+    auto buttonArea = leftColumn.removeFromTop(136);
     recordButton.setBounds(buttonArea.removeFromTop(32).reduced(8, 2));
     playButton.setBounds(buttonArea.removeFromTop(32).reduced(8, 2));
     overdubButton.setBounds(buttonArea.removeFromTop(32).reduced(8, 2));
     clearButton.setBounds(buttonArea.removeFromTop(32).reduced(8, 2));
 
-    auto modeArea = leftColumn.removeFromTop(130);
-    halfSpeedButton.setBounds(modeArea.removeFromTop(28).reduced(8, 2));
-    reverseButton.setBounds(modeArea.removeFromTop(28).reduced(8, 2));
-    authenticButton.setBounds(modeArea.removeFromTop(28).reduced(8, 2));
-    limiterButton.setBounds(modeArea.removeFromTop(28).reduced(8, 2));
+    auto modeArea = leftColumn.removeFromTop(156);
+    halfSpeedButton.setBounds(modeArea.removeFromTop(26).reduced(8, 2));
+    reverseButton.setBounds(modeArea.removeFromTop(26).reduced(8, 2));
+    authenticButton.setBounds(modeArea.removeFromTop(26).reduced(8, 2));
+    limiterButton.setBounds(modeArea.removeFromTop(26).reduced(8, 2));
+    hqPlaybackButton.setBounds(modeArea.removeFromTop(26).reduced(8, 2));
+    cleanCaptureButton.setBounds(modeArea.removeFromTop(26).reduced(8, 2));
 
-    auto ledArea = leftColumn.removeFromTop(32).reduced(8, 6);
-    const auto recLed = ledArea.removeFromLeft(20);
-    ledArea.removeFromLeft(8);
-    const auto playLed = ledArea.removeFromLeft(20);
-    ledArea.removeFromLeft(8);
-    const auto overdubLed = ledArea.removeFromLeft(20);
+    area.removeFromTop(kStatusGap);
+    loopStatus.setBounds(area.removeFromTop(kStatusHeight).withWidth(mainPanelBounds.getWidth()));
 
     background.setBounds(getLocalBounds());
     background.setPanels(header.toFloat(),
                          leftPanelBounds.withTrimmedTop(4).withTrimmedBottom(6).toFloat(),
                          mainPanelBounds.withTrimmedTop(-8).withTrimmedBottom(20).toFloat(),
                          rightPanelBounds.withTrimmedTop(-8).withTrimmedBottom(20).toFloat());
-    background.setMeterData(meterL, meterR);
+    background.setMeterData(engineStatus.meterL, engineStatus.meterR);
 }
 
 void SixteenSecondAudioProcessorEditor::timerCallback()
 {
-    meterL = processor.getMeterL();
-    meterR = processor.getMeterR();
-    clipOn = processor.getClip();
-    recOn = processor.getAPVTS().getRawParameterValue("record")->load() > 0.5f;
-    playOn = processor.getAPVTS().getRawParameterValue("play")->load() > 0.5f;
-    overdubOn = processor.getAPVTS().getRawParameterValue("overdub")->load() > 0.5f;
-    background.setMeterData(meterL, meterR);
+    // One read for everything the engine reports; a failed read keeps the previous frame.
+    processor.getEngineStatus(engineStatus);
+    background.setMeterData(engineStatus.meterL, engineStatus.meterR);
+    loopStatus.setStatus(engineStatus);
+
+    midiButton.setButtonText(processor.getFootswitchMap().isLearning() ? "Learn..." : "MIDI");
+    updateExportStatus();
+    updateImportStatus();
+
+    const auto& watchdog = processor.getWatchdog();
+    const auto faults = watchdog.getNanCount() + watchdog.getInfCount();
+    watchdogLabel.setText(faults == 0 && watchdog.getDenormalCount() == 0
+                              ? juce::String()
+                              : "NaN " + juce::String(watchdog.getNanCount())
+                                    + "  Inf " + juce::String(watchdog.getInfCount())
+                                    + "  Den " + juce::String(watchdog.getDenormalCount())
+                                    + "  Recovered " + juce::String(watchdog.getRecoveryCount()),
+                          juce::dontSendNotification);
+    repaint();
+}
+
+void SixteenSecondAudioProcessorEditor::chooseExportFile()
+{
+    const auto folder = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory);
+    exportChooser = std::make_unique<juce::FileChooser>("Export loop", folder.getChildFile("16-Second Loop.wav"),
+                                                        "*.wav;*.flac;*.aif;*.aiff");
+    exportChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles
+                                   | juce::FileBrowserComponent::warnAboutOverwriting,
+                               [this](const juce::FileChooser& chooser)
+                               {
+                                   const auto file = chooser.getResult();
+                                   if (file != juce::File() && processor.exportLoop(file))
+                                       lastExportStatus = LoopExporter::Status::Capturing;
+                               });
+}
+
+void SixteenSecondAudioProcessorEditor::updateExportStatus()
+{
+    const auto status = processor.getExportStatus();
+    const auto busy = status == LoopExporter::Status::Capturing || status == LoopExporter::Status::Writing;
+    exportButton.setButtonText(busy ? "Saving..." : "Export");
+    exportButton.setEnabled(!busy);
+
+    if (status == lastExportStatus)
+        return;
+
+    lastExportStatus = status;
+    juce::String problem;
+    if (status == LoopExporter::Status::NoLoop)
+        problem = "There is no loop to export yet. Record one first.";
+    else if (status == LoopExporter::Status::Interrupted)
+        problem = "The export was interrupted by a sample-rate or storage change, or the host stopped "
+                  "processing audio. Please try again while the plug-in is running.";
+    else if (status == LoopExporter::Status::WriteFailed)
+        problem = "The file could not be written.";
+
+    if (problem.isNotEmpty())
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Export loop", problem);
+}
+
+void SixteenSecondAudioProcessorEditor::updateImportStatus()
+{
+    const auto status = processor.getImportStatus();
+    if (status == lastImportStatus)
+        return;
+
+    lastImportStatus = status;
+    if (status == LoopImporter::Status::Unreadable)
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Load loop",
+                                               "The file could not be read as audio.");
+    else if (status == LoopImporter::Status::Interrupted)
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Load loop",
+                                               "Loading was interrupted by a sample-rate or layout change. Please try again.");
+}
+
+bool SixteenSecondAudioProcessorEditor::isInterestedInFileDrag(const juce::StringArray& files)
+{
+    return files.size() == 1 && LoopImporter::canRead(juce::File(files[0]));
+}
+
+void SixteenSecondAudioProcessorEditor::fileDragEnter(const juce::StringArray&, int, int)
+{
+    fileDragOver = true;
+    repaint();
+}
+
+void SixteenSecondAudioProcessorEditor::fileDragExit(const juce::StringArray&)
+{
+    fileDragOver = false;
     repaint();
 }
+
+void SixteenSecondAudioProcessorEditor::filesDropped(const juce::StringArray& files, int, int)
+{
+    fileDragOver = false;
+    repaint();
+
+    if (processor.importLoop(juce::File(files[0])))
+        lastImportStatus = LoopImporter::Status::Loading;
+}
+
+void SixteenSecondAudioProcessorEditor::showMidiMenu()
+{
+    auto& map = processor.getFootswitchMap();
+
+    juce::PopupMenu menu;
+    menu.addSectionHeader("Learn footswitch");
+    for (int i = 0; i < MidiFootswitchMap::numActions; ++i)
+    {
+        const auto action = static_cast<FootswitchAction>(i);
+        menu.addItem(i + 1,
+                     juce::String(MidiFootswitchMap::getActionName(action)) + "  (" + describeBinding(map.getBinding(action)) + ")",
+                     true,
+                     map.isLearning() && map.getLearnTarget() == action);
+    }
+
+    menu.addSeparator();
+    menu.addItem(100, "Cancel learn", map.isLearning());
+    menu.addItem(101, "Reset to defaults");
+
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(&midiButton),
+                       [this](int result)
+                       {
+                           auto& footswitches = processor.getFootswitchMap();
+                           if (result >= 1 && result <= MidiFootswitchMap::numActions)
+                               footswitches.beginLearn(static_cast<FootswitchAction>(result - 1));
+                           else if (result == 100)
+                               footswitches.cancelLearn();
+                           else if (result == 101)
+                               footswitches.resetToDefaults();
+                       });
+}
@@ -4,8 +4,10 @@
 #include "PluginProcessor.h"
 #include "HouseLookAndFeel.h"
 #include "BackgroundWavesComponent.h"
+#include "LoopStatusComponent.h"
 
 class SixteenSecondAudioProcessorEditor final : public juce::AudioProcessorEditor,
+                                                public juce::FileDragAndDropTarget,
                                                 private juce::Timer
 {
 public:
@@ -13,13 +15,26 @@ public:
     ~SixteenSecondAudioProcessorEditor() override;
 
     void paint(juce::Graphics&) override;
+    void paintOverChildren(juce::Graphics&) override;
     void resized() override;
     void timerCallback() override;
 
+    // Dropping an audio file on the editor loads it as the loop.
+    bool isInterestedInFileDrag(const juce::StringArray& files) override;
+    void fileDragEnter(const juce::StringArray& files, int x, int y) override;
+    void fileDragExit(const juce::StringArray& files) override;
+    void filesDropped(const juce::StringArray& files, int x, int y) override;
+
 private:
+    void showMidiMenu();
+    void chooseExportFile();
+    void updateExportStatus();
+    void updateImportStatus();
+
     SixteenSecondAudioProcessor& processor;
     HouseLookAndFeel lookAndFeel;
     BackgroundWavesComponent background;
+    LoopStatusComponent loopStatus;
 
     juce::Slider delayTimeSlider;
     juce::Label delayTimeLabel;
@@ -45,6 +60,10 @@ private:
     juce::Label filterLabel;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> filterAttachment;
 
+    juce::Slider resonanceSlider;
+    juce::Label resonanceLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> resonanceAttachment;
+
     juce::Slider noiseSlider;
     juce::Label noiseLabel;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> noiseAttachment;
@@ -57,6 +76,10 @@ private:
     juce::Label modSpeedLabel;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> modSpeedAttachment;
 
+    juce::Slider speedSlider;
+    juce::Label speedLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> speedAttachment;
+
     juce::Slider outputGainSlider;
     juce::Label outputGainLabel;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> outputGainAttachment;
@@ -69,6 +92,8 @@ private:
     juce::ToggleButton reverseButton;
     juce::ToggleButton authenticButton;
     juce::ToggleButton limiterButton;
+    juce::ToggleButton hqPlaybackButton;
+    juce::ToggleButton cleanCaptureButton;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> recordAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> playAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> overdubAttachment;
@@ -77,13 +102,24 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> reverseAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> authenticAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> limiterAttachment;
-
-    float meterL = 0.0f;
-    float meterR = 0.0f;
-    bool clipOn = false;
-    bool recOn = false;
-    bool playOn = false;
-    bool overdubOn = false;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> hqPlaybackAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> cleanCaptureAttachment;
+
+    juce::ComboBox storageBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> storageAttachment;
+    juce::ComboBox filterModeBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterModeAttachment;
+
+    juce::Label watchdogLabel;
+    juce::TextButton traceButton;
+    juce::TextButton midiButton;
+    juce::TextButton exportButton;
+    std::unique_ptr<juce::FileChooser> exportChooser;
+    LoopExporter::Status lastExportStatus = LoopExporter::Status::Idle;
+    LoopImporter::Status lastImportStatus = LoopImporter::Status::Idle;
+    bool fileDragOver = false;
+
+    EngineStatus engineStatus;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SixteenSecondAudioProcessorEditor)
 };
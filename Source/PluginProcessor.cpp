@@ -2,6 +2,59 @@
 #include "PluginEditor.h"
 
 #include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    constexpr const char* kTracedParameterIds[] = {
+        "delayTime", "feedback", "mix", "overdubLevel", "erodeAmount", "outputGain",
+        "record", "play", "overdub", "clear", "halfSpeed", "reverse", "authentic",
+        "filter", "resonance", "filterMode", "noise", "modDepth", "modSpeed", "limiter", "speed", "hqPlayback",
+        "cleanCapture",
+        "tap1Time", "tap1Level", "tap1Pan", "tap1Feedback",
+        "tap2Time", "tap2Level", "tap2Pan", "tap2Feedback",
+        "tap3Time", "tap3Level", "tap3Pan", "tap3Feedback",
+        "tap4Time", "tap4Level", "tap4Pan", "tap4Feedback"
+    };
+
+    // Order matches SixteenSecondAudioProcessor::EngineParameter.
+    constexpr const char* kEngineParameterIds[] = {
+        "delayTime", "feedback", "mix", "overdubLevel", "erodeAmount", "filter", "resonance", "noise", "modDepth",
+        "modSpeed", "outputGain", "speed", "limiter", "authentic", "hqPlayback", "cleanCapture", "filterMode",
+        "tap1Time", "tap1Level", "tap1Pan", "tap1Feedback",
+        "tap2Time", "tap2Level", "tap2Pan", "tap2Feedback",
+        "tap3Time", "tap3Level", "tap3Pan", "tap3Feedback",
+        "tap4Time", "tap4Level", "tap4Pan", "tap4Feedback"
+    };
+
+    constexpr float kDefaultTapTimes[] = { 0.25f, 0.5f, 0.75f, 0.375f };
+    constexpr float kDefaultTapPans[] = { -0.6f, 0.6f, -0.3f, 0.3f };
+
+    constexpr SampleFormat kStorageFormats[] = { SampleFormat::Float32, SampleFormat::Int16, SampleFormat::Int12 };
+
+    juce::String getTapParameterId(int tap, const char* suffix)
+    {
+        return "tap" + juce::String(tap + 1) + suffix;
+    }
+
+    constexpr const char* kFootswitchParameterIds[] = {
+        "record", "play", "overdub", nullptr, "reverse", "halfSpeed"
+    };
+
+    const char* getStateName(int state)
+    {
+        switch (static_cast<LoopState>(state))
+        {
+            case LoopState::Idle: return "Idle";
+            case LoopState::Record: return "Record";
+            case LoopState::Play: return "Play";
+            case LoopState::Overdub: return "Overdub";
+        }
+
+        return "?";
+    }
+}
 
 SixteenSecondAudioProcessor::SixteenSecondAudioProcessor()
     : AudioProcessor(BusesProperties()
@@ -10,9 +63,39 @@ SixteenSecondAudioProcessor::SixteenSecondAudioProcessor()
       apvts(*this, nullptr, "PARAMS", createParameterLayout())
 {
     initializePresets();
+
+    for (const auto* id : kTracedParameterIds)
+    {
+        if (auto* value = apvts.getRawParameterValue(id))
+            tracedParameters.push_back({ id, value, value->load() });
+    }
+
+    static_assert(std::size(kEngineParameterIds) == numEngineParameters, "engine parameter table out of sync");
+    for (size_t i = 0; i < engineParameters.size(); ++i)
+    {
+        engineParameters[i] = apvts.getRawParameterValue(kEngineParameterIds[i]);
+        lastEngineValues[i] = engineParameters[i]->load();
+    }
+
+    for (size_t i = 0; i < footswitchParameters.size(); ++i)
+    {
+        if (kFootswitchParameterIds[i] != nullptr)
+            footswitchParameters[i] = apvts.getRawParameterValue(kFootswitchParameterIds[i]);
+    }
+    clearParameter = apvts.getRawParameterValue("clear");
+
+    multiTap.setNumTaps(numTaps);
+
+    for (auto& pending : pendingToggleSync)
+        pending.store(-1);
+
+    startTimerHz(30);
 }
 
-SixteenSecondAudioProcessor::~SixteenSecondAudioProcessor() = default;
+SixteenSecondAudioProcessor::~SixteenSecondAudioProcessor()
+{
+    stopTimer();
+}
 
 const juce::String SixteenSecondAudioProcessor::getName() const
 {
@@ -36,7 +119,26 @@ bool SixteenSecondAudioProcessor::isMidiEffect() const
 
 double SixteenSecondAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // A running loop never dies away; a delay tail lasts until the repeats fall below the
+    // silence threshold. Tap feedback sends add to the loop gain.
+    if (apvts.getRawParameterValue("play")->load() > 0.5f || apvts.getRawParameterValue("overdub")->load() > 0.5f)
+        return std::numeric_limits<double>::infinity();
+
+    auto loopGain = static_cast<double>(engineParameters[Feedback]->load());
+    for (int tap = 0; tap < numTaps; ++tap)
+        loopGain += static_cast<double>(engineParameters[static_cast<size_t>(FirstTapParameter + tap * 4 + 3)]->load());
+
+    if (loopGain >= 1.0)
+        return std::numeric_limits<double>::infinity();
+
+    const auto maxSeconds = 16.0;
+    const auto modSeconds = static_cast<double>(apvts.getRawParameterValue("modDepth")->load()) * 0.02 * maxSeconds;
+    const auto passSeconds = static_cast<double>(apvts.getRawParameterValue("delayTime")->load()) / 1000.0 + modSeconds;
+    if (loopGain <= 0.0)
+        return passSeconds;
+
+    const auto repeats = std::ceil(std::log(static_cast<double>(silenceThreshold)) / std::log(loopGain));
+    return passSeconds * (1.0 + repeats);
 }
 
 int SixteenSecondAudioProcessor::getNumPrograms()
@@ -54,8 +156,12 @@ void SixteenSecondAudioProcessor::setCurrentProgram(int index)
     if (index < 0 || index >= getNumPrograms())
         return;
 
+    // The engine picks the whole preset up with one swap on its next block and ramps to it; the
+    // host parameters follow from the timer in a single batch.
     currentProgram = index;
-    presets[static_cast<size_t>(index)].apply(apvts);
+    presetGeneration.fetch_add(1);
+    pendingPreset.store(presets[static_cast<size_t>(index)].bundle.get());
+    pendingPresetNotify.store(index);
 }
 
 const juce::String SixteenSecondAudioProcessor::getProgramName(int index)
@@ -71,16 +177,55 @@ void SixteenSecondAudioProcessor::changeProgramName(int, const juce::String&)
 
 void SixteenSecondAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    const auto maxSeconds = 16.0;
-    maxBufferSamples = static_cast<int>(std::ceil(sampleRate * maxSeconds));
-    memoryBuffer.prepare(getTotalNumInputChannels(), maxBufferSamples);
-    tempFloatBuffer.setSize(getTotalNumInputChannels(), samplesPerBlock);
+    // Scratch space is sized per chunk, so repeated calls reuse it without allocating.
+    noiseBlock.assign(static_cast<size_t>(std::max(1, getTotalNumInputChannels()) * renderChunkSize), 0.0f);
+    readIndexBlock.assign(static_cast<size_t>(renderChunkSize), 0);
+    overdubIndexBlock.assign(static_cast<size_t>(renderChunkSize), 0);
+    captureBlock.assign(static_cast<size_t>(std::max(1, getTotalNumInputChannels()) * renderChunkSize), 0.0f);
+    readFractionBlock.assign(static_cast<size_t>(renderChunkSize), 0.0f);
+    readBlock.assign(static_cast<size_t>(std::max(1, getTotalNumInputChannels()) * renderChunkSize), 0.0f);
+    tapOutputBlock.assign(static_cast<size_t>(std::max(1, getTotalNumInputChannels()) * renderChunkSize), 0.0f);
+    tapSendBlock.assign(static_cast<size_t>(std::max(1, getTotalNumInputChannels()) * renderChunkSize), 0.0f);
+    fadeIndexBlock.assign(static_cast<size_t>(renderChunkSize), 0);
+    fadeFractionBlock.assign(static_cast<size_t>(renderChunkSize), 0.0f);
+    fadeGainBlock.assign(static_cast<size_t>(renderChunkSize), 1.0f);
+    fadeReadBlock.assign(static_cast<size_t>(std::max(1, getTotalNumInputChannels()) * renderChunkSize), 0.0f);
+    delayBlock.assign(static_cast<size_t>(renderChunkSize), 0.0f);
+    wetBlock.assign(static_cast<size_t>(std::max(1, getTotalNumInputChannels()) * renderChunkSize), 0.0f);
+    tempFloatBuffer.setSize(getTotalNumInputChannels(), samplesPerBlock, false, false, true);
+    sliceMidi.ensureSize(4096);
+
+    // Nothing is sounding yet, so a preset picked before playback starts lands without a ramp.
+    const auto* pending = pendingPreset.load();
+    for (size_t i = 0; i < lastEngineValues.size(); ++i)
+    {
+        const auto hasPresetValue = pending != nullptr && pending->hasEngineValue[i];
+        lastEngineValues[i] = hasPresetValue ? pending->engine[i] : engineParameters[i]->load();
+    }
+
+    // Hosts re-prepare on transport and block-size changes; with the same rate and layout the
+    // delay memory, the loop in it and the engine state carry straight on.
+    if (sampleRate == preparedSampleRate && getTotalNumInputChannels() == preparedChannels)
+        return;
+
+    preparedSampleRate = sampleRate;
+    preparedChannels = getTotalNumInputChannels();
+    provisionedFormat = getStorageFormat();
+
+    noiseSource.prepare(getTotalNumInputChannels());
+    multiTap.prepare(renderChunkSize);
+    loopResampler.prepare();
     delaySmoother.reset(sampleRate, 0.0f, 10.0f);
+    delaySmoother.setStepMs(2.5f);
     feedbackModel.reset(sampleRate);
-    limiterL.reset(sampleRate);
-    limiterR.reset(sampleRate);
+    limiter.reset(sampleRate);
     lfo.reset(sampleRate);
-    resetLoopState();
+
+    // The new memory is built off the audio thread; processBlock passes audio through dry until it
+    // is swapped in. The newest content carries over, resampled when the rate changed.
+    bufferProvisioner.request(makeBufferLayout(), makeBufferSource());
+    if (isNonRealtime())
+        bufferProvisioner.waitUntilReady();
 }
 
 void SixteenSecondAudioProcessor::releaseResources()
@@ -98,64 +243,233 @@ bool SixteenSecondAudioProcessor::isBusesLayoutSupported(const BusesLayout& layo
 }
 
 template <typename SampleType>
-void SixteenSecondAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleType>& buffer)
+void SixteenSecondAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleType>& buffer,
+                                                       const juce::MidiBuffer& midiMessages)
 {
-    const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
 
-    const auto delayMs = apvts.getRawParameterValue("delayTime")->load();
-    const auto feedback = apvts.getRawParameterValue("feedback")->load();
-    const auto mix = apvts.getRawParameterValue("mix")->load();
-    const auto overdubLevel = apvts.getRawParameterValue("overdubLevel")->load();
-    const auto erodeAmount = apvts.getRawParameterValue("erodeAmount")->load();
-    const auto filterAmount = apvts.getRawParameterValue("filter")->load();
-    const auto noiseAmount = apvts.getRawParameterValue("noise")->load();
-    const auto modDepth = apvts.getRawParameterValue("modDepth")->load();
-    const auto modSpeed = apvts.getRawParameterValue("modSpeed")->load();
-    const auto gainDb = apvts.getRawParameterValue("outputGain")->load();
-    const auto limiterOn = apvts.getRawParameterValue("limiter")->load() > 0.5f;
-    const auto gain = juce::Decibels::decibelsToGain(static_cast<SampleType>(gainDb));
-    const auto isRecording = apvts.getRawParameterValue("record")->load() > 0.5f;
-    const auto isPlaying = apvts.getRawParameterValue("play")->load() > 0.5f;
-    const auto isOverdubbing = apvts.getRawParameterValue("overdub")->load() > 0.5f;
-    const auto isClear = apvts.getRawParameterValue("clear")->load() > 0.5f;
-    const auto isHalfSpeed = apvts.getRawParameterValue("halfSpeed")->load() > 0.5f;
-    const auto isReverse = apvts.getRawParameterValue("reverse")->load() > 0.5f;
-    const auto isAuthentic = apvts.getRawParameterValue("authentic")->load() > 0.5f;
-
-    if (maxBufferSamples <= 0 || memoryBuffer.getSize() <= 0)
+    EngineValues values;
+    pullEngineValues(values, numSamples);
+
+    BlockParameters params;
+    params.delayMs = values[DelayTime];
+    params.feedback = values[Feedback];
+    params.overdubLevel = values[OverdubLevel];
+    params.erodeAmount = values[ErodeAmount];
+    params.tone.filterAmount = values[Filter];
+    params.tone.resonance = values[Resonance];
+    params.tone.mode = static_cast<StateVariableFilter::Mode>(juce::jlimit(0, 2, juce::roundToInt(values[FilterMode])));
+    params.noiseAmount = values[Noise];
+    params.limiterOn = values[LimiterOn] > 0.5f;
+    params.isAuthentic = values[Authentic] > 0.5f;
+    params.speed = values[Speed];
+    params.hqPlayback = values[HqPlayback] > 0.5f;
+    params.cleanCapture = values[CleanCapture] > 0.5f;
+    params.rateRampSamples = static_cast<int>(getSampleRate() * 0.01);
+    params.headFadeSamples = static_cast<int>(getSampleRate() * 0.005);
+
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        const auto* tapValues = values.data() + FirstTapParameter + tap * 4;
+        params.tapTimes[static_cast<size_t>(tap)] = tapValues[0];
+        multiTap.setTap(tap, { multiTap.getTap(tap).delaySamples, tapValues[1], tapValues[2], tapValues[3] });
+    }
+    params.gain = juce::Decibels::decibelsToGain(values[OutputGain]);
+    const auto mix = values[Mix];
+    const auto modDepth = values[ModDepth];
+    const auto modSpeed = values[ModSpeed];
+    const auto isClear = clearParameter->load() > 0.5f;
+
+    numWriteSpans = 0;
+    traceParameterChanges();
+    syncFootswitchToggles();
+
+    BufferProvisioner::Placement placement;
+    if (bufferProvisioner.take(memoryBuffer, placement))
+        adoptProvisionedBuffer(placement);
+
+    // While a replacement is being copied out of the current memory it must stay untouched.
+    if (bufferProvisioner.isPending() || maxBufferSamples <= 0 || memoryBuffer.getSize() <= 0)
         return;
 
-    const auto targetDelaySamples =
+    loopSnapshot.advance(memoryBuffer, loopStartIndex, loopLengthSamples, memorySampleRate, snapshotPagesPerBlock);
+
+    // An imported file streams into memory a few pages per block; the input passes through dry
+    // until the whole loop is in.
+    if (importStream.getState() == LoopImportStream::State::Streaming)
+    {
+        streamImportedLoop();
+        return;
+    }
+
+    params.targetDelaySamples =
         juce::jlimit(0, maxBufferSamples - 1,
-                     static_cast<int>(delayMs * (getSampleRate() / 1000.0)));
+                     static_cast<int>(params.delayMs * (getSampleRate() / 1000.0)));
 
     const auto modHz = 0.05f + modSpeed * (8.0f - 0.05f);
     lfo.setFrequency(modHz);
 
     const auto maxModSamples = static_cast<float>(maxBufferSamples) * 0.02f;
-    const auto modDepthSamples = juce::jlimit(0.0f, maxModSamples, modDepth * maxModSamples);
+    params.modDepthSamples = juce::jlimit(0.0f, maxModSamples, modDepth * maxModSamples);
+
+    // AUTHENTIC zippers through delay changes in coarse held steps; SAFE-ish glides.
+    delaySmoother.setShape(params.isAuthentic ? Smoother::Shape::Stepped : Smoother::Shape::Exponential);
+    delaySmoother.setTarget(static_cast<float>(params.targetDelaySamples));
 
-    if (!isAuthentic)
+    const auto mixClamped = juce::jlimit(0.0f, 1.0f, mix);
+    params.dryGain = std::cos(mixClamped * juce::MathConstants<float>::halfPi);
+    params.wetGain = std::sin(mixClamped * juce::MathConstants<float>::halfPi);
+
+    limiter.setThreshold(0.98f);
+
+    auto clearEdge = isClear && !lastClear;
+    lastClear = isClear;
+
+    // Idle sleep: nothing to hear and nothing stored within reach of the read heads, so only the
+    // (sub-threshold) dry path is output. The first asleep block fades the last awake output
+    // value out, so a held offset neither clicks nor stays on as DC. Any input, MIDI or state
+    // command wakes it immediately.
+    if (canSleep(buffer, midiMessages, params, clearEdge))
     {
-        delaySmoother.setTimeMs(10.0f);
-        delaySmoother.setTarget(static_cast<float>(targetDelaySamples));
+        const auto wasSleeping = sleeping.exchange(true);
+        const auto dryGain = static_cast<SampleType>(params.dryGain * params.gain);
+        const auto fadeStep = 1.0f / static_cast<float>(numSamples);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* output = buffer.getWritePointer(channel);
+            for (int i = 0; i < numSamples; ++i)
+                output[i] *= dryGain;
+
+            if (!wasSleeping)
+            {
+                const auto hold = sleepHold[static_cast<size_t>(std::min(channel, 1))];
+                for (int i = 0; i < numSamples; ++i)
+                    output[i] += static_cast<SampleType>(hold * (1.0f - fadeStep * static_cast<float>(i + 1)));
+            }
+        }
+
+        sleepHold.fill(0.0f);
+        return;
     }
-    else
+
+    sleeping.store(false);
+
+    // Footswitch events split the block so state changes land on their exact sample.
+    auto position = 0;
+    for (const auto metadata : midiMessages)
     {
-        delaySmoother.setTarget(static_cast<float>(targetDelaySamples));
-        delaySmoother.process();
+        // Footswitches are short channel messages; longer ones (SysEx) would allocate a MidiMessage.
+        FootswitchAction action;
+        if (metadata.numBytes > 3 || !resolveFootswitch(metadata.getMessage(), action))
+            continue;
+
+        const auto offset = juce::jlimit(0, numSamples, metadata.samplePosition);
+        if (offset > position)
+        {
+            processSegment(buffer, position, offset - position, params, clearEdge);
+            clearEdge = false;
+            position = offset;
+        }
+
+        eventTrace.push(processedSamples + static_cast<std::uint64_t>(offset), TraceEvent::Type::Footswitch,
+                        static_cast<int>(action), 0.0f, 1.0f);
+
+        if (action == FootswitchAction::Clear)
+            clearEdge = true;
+        else
+            toggleFootswitch(action);
     }
 
-    const auto mixClamped = juce::jlimit(0.0f, 1.0f, mix);
-    const auto dryGain = std::cos(mixClamped * juce::MathConstants<float>::halfPi);
-    const auto wetGain = std::sin(mixClamped * juce::MathConstants<float>::halfPi);
+    processSegment(buffer, position, numSamples - position, params, clearEdge);
 
-    limiterL.setThreshold(0.98f);
-    limiterR.setThreshold(0.98f);
+    for (int channel = 0; channel < std::min(buffer.getNumChannels(), 2); ++channel)
+        sleepHold[static_cast<size_t>(channel)] = static_cast<float>(buffer.getSample(channel, numSamples - 1));
+}
 
-    const auto clearEdge = isClear && !lastClear;
-    lastClear = isClear;
+void SixteenSecondAudioProcessor::pullEngineValues(EngineValues& values, int numSamples)
+{
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = engineParameters[i]->load();
+
+    if (const auto* bundle = pendingPreset.exchange(nullptr))
+    {
+        activePreset = bundle;
+        activePresetGeneration = presetGeneration.load();
+        presetRampStart = lastEngineValues;
+        presetRampPosition = 0;
+        applyPresetToggles(*bundle);
+    }
+
+    // Until the host parameters have caught up, the preset bundle is the source of truth;
+    // continuous values ramp towards it, switches flip at once.
+    if (activePreset != nullptr)
+    {
+        const auto rampSamples = std::max(1, static_cast<int>(getSampleRate() * 0.03));
+        presetRampPosition = std::min(rampSamples, presetRampPosition + numSamples);
+        const auto amount = static_cast<float>(presetRampPosition) / static_cast<float>(rampSamples);
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (!activePreset->hasEngineValue[i])
+                continue;
+
+            const auto target = activePreset->engine[i];
+            const auto isSwitch = i >= LimiterOn && i <= FilterMode;
+            values[i] = isSwitch ? target : presetRampStart[i] + (target - presetRampStart[i]) * amount;
+        }
+
+        if (presetRampPosition >= rampSamples && syncedPresetGeneration.load() >= activePresetGeneration)
+            activePreset = nullptr;
+    }
+
+    lastEngineValues = values;
+}
+
+template <typename SampleType>
+bool SixteenSecondAudioProcessor::canSleep(const juce::AudioBuffer<SampleType>& buffer,
+                                           const juce::MidiBuffer& midiMessages,
+                                           const BlockParameters& params,
+                                           bool clearEdge) const
+{
+    if (clearEdge || currentState != LoopState::Idle || !midiMessages.isEmpty() || headFade.isActive())
+        return false;
+
+    if (footswitchToggles[static_cast<size_t>(FootswitchAction::Record)]
+        || footswitchToggles[static_cast<size_t>(FootswitchAction::Play)]
+        || footswitchToggles[static_cast<size_t>(FootswitchAction::Overdub)])
+        return false;
+
+    // Every head (main, modulated, taps) reads within this distance of the write head.
+    const auto reach = std::max(static_cast<float>(params.targetDelaySamples), delaySmoother.getCurrent())
+                       + params.modDepthSamples + static_cast<float>(renderChunkSize);
+    if (static_cast<float>(quietWrittenSamples) < reach)
+        return false;
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        if (static_cast<float>(buffer.getMagnitude(channel, 0, buffer.getNumSamples())) > silenceThreshold)
+            return false;
+    }
+
+    return true;
+}
+
+template <typename SampleType>
+void SixteenSecondAudioProcessor::processSegment(juce::AudioBuffer<SampleType>& buffer,
+                                                 int startSample,
+                                                 int numSamples,
+                                                 const BlockParameters& params,
+                                                 bool clearEdge)
+{
+    const auto endSample = startSample + numSamples;
+    const auto segmentTime = processedSamples + static_cast<std::uint64_t>(startSample);
+    const auto isRecording = footswitchToggles[static_cast<size_t>(FootswitchAction::Record)];
+    const auto isPlaying = footswitchToggles[static_cast<size_t>(FootswitchAction::Play)];
+    const auto isOverdubbing = footswitchToggles[static_cast<size_t>(FootswitchAction::Overdub)];
+
+    if (clearEdge)
+        eventTrace.push(segmentTime, TraceEvent::Type::ClearEdge, 0, 0.0f, 1.0f);
 
     const auto hasLoop = loopLengthSamples > 0;
     const auto nextState = stateMachine.update(isRecording, isPlaying, isOverdubbing, hasLoop, clearEdge);
@@ -165,16 +479,39 @@ void SixteenSecondAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleT
 
     if (currentState != nextState)
     {
+        const auto wasPlaying = currentState == LoopState::Play || currentState == LoopState::Overdub;
+        const auto willPlay = nextState == LoopState::Play || nextState == LoopState::Overdub;
+
+        // The loop head and the delay head read unrelated parts of the buffer, so moving between
+        // them is a pointer jump: keep the outgoing head running while the new one fades in.
+        if (wasPlaying && nextState == LoopState::Idle && loopLengthSamples > 0)
+            beginHeadFade(loopStepper, loopStartIndex, params);
+        else if (currentState == LoopState::Idle && willPlay)
+            beginHeadFade(makeDelayHead(delaySmoother.getCurrent() + lastModOffset), 0, params);
+
+        eventTrace.push(segmentTime, TraceEvent::Type::StateChange, static_cast<int>(nextState),
+                        static_cast<float>(currentState), static_cast<float>(nextState));
+
         if (currentState == LoopState::Record && nextState != LoopState::Record)
         {
+            const auto previousLength = loopLengthSamples;
+            const auto previousStart = loopStartIndex;
             loopLengthSamples = juce::jlimit(1, maxBufferSamples, recordedSamples);
             loopStartIndex = memoryBuffer.getWriteIndex() - loopLengthSamples;
             if (loopStartIndex < 0)
                 loopStartIndex += maxBufferSamples;
+            eventTrace.push(segmentTime, TraceEvent::Type::LoopLength, 0,
+                            static_cast<float>(previousLength), static_cast<float>(loopLengthSamples));
+            eventTrace.push(segmentTime, TraceEvent::Type::LoopStart, 0,
+                            static_cast<float>(previousStart), static_cast<float>(loopStartIndex));
             loopReadIndex = loopStartIndex;
+            loopStepper.setLength(loopLengthSamples);
             loopStepper.reset(0.0);
         }
 
+        if (nextState == LoopState::Overdub)
+            overdubGains = Overdub::makeGains(params.overdubLevel, params.feedback, params.erodeAmount);
+
         if ((nextState == LoopState::Play || nextState == LoopState::Overdub) &&
             (currentState != LoopState::Play && currentState != LoopState::Overdub))
         {
@@ -185,28 +522,91 @@ void SixteenSecondAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleT
 
     currentState = nextState;
 
+    for (int chunkStart = startSample; chunkStart < endSample; chunkStart += renderChunkSize)
+        renderChunk(buffer, chunkStart, std::min(renderChunkSize, endSample - chunkStart), params);
+}
+
+template <typename SampleType>
+void SixteenSecondAudioProcessor::renderChunk(juce::AudioBuffer<SampleType>& buffer,
+                                              int startSample,
+                                              int numSamples,
+                                              const BlockParameters& params)
+{
+    const auto numChannels = std::min(buffer.getNumChannels(), memoryBuffer.getNumChannels());
+
+    const auto feedback = params.feedback;
+    const auto overdubLevel = params.overdubLevel;
+    const auto erodeAmount = params.erodeAmount;
+    const auto& tone = params.tone;
+    const auto noiseAmount = params.noiseAmount;
+    const auto limiterOn = params.limiterOn;
+    const auto isAuthentic = params.isAuthentic;
+    const auto gain = static_cast<SampleType>(params.gain);
+    const auto targetDelaySamples = params.targetDelaySamples;
+    const auto modDepthSamples = params.modDepthSamples;
+    const auto isHalfSpeed = footswitchToggles[static_cast<size_t>(FootswitchAction::HalfSpeed)];
+    const auto isReverse = footswitchToggles[static_cast<size_t>(FootswitchAction::Reverse)];
+
+    if (noiseAmount > 0.0f)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            noiseSource.fill(channel, getNoiseBlock(channel), numSamples);
+    }
+
     if (currentState == LoopState::Record)
     {
-        for (int i = 0; i < numSamples; ++i)
+        const auto writeStart = memoryBuffer.getWriteIndex();
+        addWriteSpan(writeStart, numSamples);
+
+        // Clean capture is a straight copy into the buffer; otherwise the chunk runs through the
+        // block form of the degrade chain first.
+        if (params.cleanCapture)
         {
             for (int channel = 0; channel < numChannels; ++channel)
+                memoryBuffer.writeBlock(channel, writeStart, buffer.getReadPointer(channel, startSample), numSamples);
+        }
+        else
+        {
+            float* captures[2] {};
+            const float* noises[2] {};
+            const auto captureChannels = std::min(numChannels, 2);
+            for (int channel = 0; channel < captureChannels; ++channel)
             {
-                const auto input = buffer.getSample(channel, i);
-                const auto degraded = feedbackModel.process(static_cast<float>(input),
-                                                            filterAmount,
-                                                            noiseAmount,
-                                                            1.0f,
-                                                            generateNoise());
-                memoryBuffer.writeSample(channel, memoryBuffer.getWriteIndex(), degraded);
-                auto output = static_cast<float>(input * gain);
-                if (limiterOn)
-                    output = (channel == 0) ? limiterL.process(output) : limiterR.process(output);
-                buffer.setSample(channel, i, static_cast<SampleType>(output));
+                const auto* input = buffer.getReadPointer(channel, startSample);
+                std::copy(input, input + numSamples, getCaptureBlock(channel));
+                captures[channel] = getCaptureBlock(channel);
+                noises[channel] = getNoiseBlock(channel);
             }
 
-            memoryBuffer.advanceWrite();
-            if (recordedSamples < maxBufferSamples)
-                ++recordedSamples;
+            feedbackModel.setParameters(tone, noiseAmount, numSamples);
+            feedbackModel.processBlock(captures, noises, captureChannels, numSamples, 1.0f);
+
+            for (int channel = 0; channel < captureChannels; ++channel)
+                memoryBuffer.writeBlock(channel, writeStart, captures[channel], numSamples);
+        }
+
+        memoryBuffer.setWriteIndex(writeStart + numSamples);
+        quietWrittenSamples = 0;
+        recordedSamples = std::min(maxBufferSamples, recordedSamples + numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel, startSample),
+                                                  static_cast<float>(gain), numSamples);
+
+        if (limiterOn)
+        {
+            // One channel per lane, the whole frame limited at once.
+            const auto lanes = std::min(numChannels, FloatLanes::size);
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                FloatLanes::Array frame {};
+                for (int channel = 0; channel < lanes; ++channel)
+                    frame[static_cast<size_t>(channel)] = static_cast<float>(buffer.getSample(channel, i));
+
+                const auto limited = limiter.process(FloatLanes::fromArray(frame)).toArray();
+                for (int channel = 0; channel < lanes; ++channel)
+                    buffer.setSample(channel, i, static_cast<SampleType>(limited[static_cast<size_t>(channel)]));
+            }
         }
 
         return;
@@ -214,111 +614,325 @@ void SixteenSecondAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleT
 
     if ((currentState == LoopState::Play || currentState == LoopState::Overdub) && loopLengthSamples > 0)
     {
+        multiTap.reset();
+
         const auto rateSign = isReverse ? -1.0 : 1.0;
-        const auto rate = (isHalfSpeed ? 0.5 : 1.0) * rateSign;
-        loopStepper.setRate(rate);
+        const auto rate = static_cast<double>(params.speed) * (isHalfSpeed ? 0.5 : 1.0) * rateSign;
+        const auto directionFlip = (rate < 0.0) != (loopStepper.getRate() < 0.0);
+        if (directionFlip && !isAuthentic)
+            beginHeadFade(loopStepper, loopStartIndex, params);
+
+        if (isAuthentic || directionFlip)
+            loopStepper.setRate(rate);
+        else
+            loopStepper.setRateSmoothed(rate, params.rateRampSamples);
+
+        const auto maxRate = std::max(std::abs(rate), std::abs(loopStepper.getRate()));
+        loopStepper.fillBlock(readIndexBlock.data(), readFractionBlock.data(), numSamples);
+
+        const auto quality = isAuthentic ? LoopResampler::Quality::Nearest
+                                         : (params.hqPlayback ? LoopResampler::Quality::Sinc
+                                                              : LoopResampler::Quality::Linear);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const auto loop = makeLoopView(channel, loopStartIndex, loopLengthSamples);
+            loopResampler.process(loop, readIndexBlock.data(), readFractionBlock.data(), getReadBlock(channel),
+                                  numSamples, quality, maxRate);
+        }
 
-        for (int i = 0; i < numSamples; ++i)
+        const auto fading = renderHeadFade(numChannels, numSamples, quality);
+
+        if (currentState == LoopState::Overdub)
         {
-            const auto readIndex = loopStartIndex + loopStepper.getIndex(loopLengthSamples);
+            const auto traversed = static_cast<int>(std::ceil(maxRate * numSamples)) + 1;
+            addLoopWriteSpan(readIndexBlock[0], traversed, isReverse);
+
+            const auto bufferSize = memoryBuffer.getSize();
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto index = loopStartIndex + readIndexBlock[static_cast<size_t>(i)];
+                overdubIndexBlock[static_cast<size_t>(i)] = index >= bufferSize ? index - bufferSize : index;
+            }
+
+            float* loops[2] {};
+            std::int16_t* packedLoops[2] {};
+            const float* inputs[2] {};
+            const float* reads[2] {};
+            const float* noises[2] {};
+            const auto kernelChannels = std::min(numChannels, 2);
+            for (int channel = 0; channel < kernelChannels; ++channel)
+            {
+                loops[channel] = memoryBuffer.getWritePointer(channel);
+                packedLoops[channel] = memoryBuffer.getPackedWritePointer(channel);
+                inputs[channel] = buffer.getReadPointer(channel, startSample);
+                reads[channel] = getReadBlock(channel);
+                noises[channel] = getNoiseBlock(channel);
+            }
+
+            // Overdub writes only touch the loop, which this chunk has already read into readBlock,
+            // so the whole chunk is written back before the output pass.
+            const auto targetGains = Overdub::makeGains(overdubLevel, feedback, erodeAmount);
+            feedbackModel.setParameters(tone, noiseAmount, numSamples);
+            Overdub::processBlock({ loops, inputs, reads, noises, overdubIndexBlock.data(), kernelChannels, numSamples,
+                                    memoryBuffer.isPacked() ? packedLoops : nullptr, memoryBuffer.getCodec() },
+                                  feedbackModel, overdubGains, targetGains);
+            overdubGains = targetGains;
+            quietWrittenSamples = 0;
+        }
 
+        if (fading)
+        {
             for (int channel = 0; channel < numChannels; ++channel)
             {
-                const auto input = buffer.getSample(channel, i);
-                const auto readSample = memoryBuffer.readSample(channel, readIndex);
-                const auto mixed = static_cast<SampleType>(input * dryGain + readSample * wetGain);
-                auto output = static_cast<float>(mixed * gain);
-                if (limiterOn)
-                    output = (channel == 0) ? limiterL.process(output) : limiterR.process(output);
-                buffer.setSample(channel, i, static_cast<SampleType>(output));
-
-                if (currentState == LoopState::Overdub)
+                auto* read = getReadBlock(channel);
+                const auto* fadeRead = getFadeReadBlock(channel);
+                for (int i = 0; i < numSamples; ++i)
                 {
-                    const auto existing = readSample;
-                    const auto overdubWrite = Overdub::apply(existing,
-                                                             static_cast<float>(input),
-                                                             readSample,
-                                                             overdubLevel,
-                                                             feedback,
-                                                             erodeAmount);
-                    const auto degraded = feedbackModel.process(overdubWrite,
-                                                                filterAmount,
-                                                                noiseAmount,
-                                                                1.0f,
-                                                                generateNoise());
-                    memoryBuffer.writeSample(channel, readIndex, degraded);
+                    const auto fadeGain = fadeGainBlock[static_cast<size_t>(i)];
+                    read[i] = read[i] * fadeGain + fadeRead[i] * (1.0f - fadeGain);
                 }
             }
-
-            loopStepper.advance();
         }
+
+        writeChunkOutput(buffer, startSample, numSamples, numChannels, readBlock.data(), params);
         return;
     }
 
+    addWriteSpan(memoryBuffer.getWriteIndex(), numSamples);
+
+    // A large delay change jumps straight to the new time under a crossfade instead of sweeping
+    // the pitch across the whole distance. Only delays longer than a chunk can be faded out:
+    // shorter ones would read samples this chunk has not written yet.
+    const auto currentDelay = delaySmoother.getCurrent();
+    if (!isAuthentic && !headFade.isActive()
+        && std::abs(static_cast<float>(targetDelaySamples) - currentDelay) > static_cast<float>(params.headFadeSamples * 4)
+        && currentDelay + lastModOffset >= static_cast<float>(renderChunkSize))
+    {
+        beginHeadFade(makeDelayHead(currentDelay + lastModOffset), 0, params);
+        delaySmoother.reset(getSampleRate(), static_cast<float>(targetDelaySamples), 10.0f);
+    }
+
+    const auto fading = renderHeadFade(numChannels, numSamples, LoopResampler::Quality::Linear);
+
+    // Taps are placed as fractions of the delay time and held for the chunk, at least a sample
+    // behind the write head; the kernel reads the ones closer than the chunk as it writes.
+    const auto tapping = multiTap.isActive() && numChannels <= 2;
+    if (tapping)
+    {
+        const auto baseDelay = delaySmoother.getCurrent();
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            auto settings = multiTap.getTap(tap);
+            settings.delaySamples = juce::jlimit(1.0f, static_cast<float>(maxBufferSamples - 1),
+                                                 baseDelay * params.tapTimes[static_cast<size_t>(tap)]);
+            multiTap.setTap(tap, settings);
+        }
+
+        float* tapOutputs[] = { getTapOutputBlock(0), getTapOutputBlock(numChannels > 1 ? 1 : 0) };
+        float* tapSends[] = { getTapSendBlock(0), getTapSendBlock(numChannels > 1 ? 1 : 0) };
+        multiTap.process(memoryBuffer, memoryBuffer.getWriteIndex(), tapOutputs, tapSends, numChannels, numSamples);
+    }
+
+    // Read distances per frame: the smoother writes the chunk's ramp (a constant run once it has
+    // settled), then the modulation is added on top.
+    delaySmoother.process(delayBlock.data(), numSamples);
     for (int i = 0; i < numSamples; ++i)
     {
-        const auto modOffset = lfo.process() * modDepthSamples;
-        const auto delaySamples = isAuthentic
-                                      ? static_cast<float>(targetDelaySamples) + modOffset
-                                      : delaySmoother.process() + modOffset;
-        const auto writeIndex = memoryBuffer.getWriteIndex();
-        const auto readIndex = static_cast<float>(writeIndex) - delaySamples;
+        lastModOffset = lfo.process() * modDepthSamples;
+        delayBlock[static_cast<size_t>(i)] += lastModOffset;
+    }
+
+    const float* inputs[2] {};
+    float* wets[2] {};
+    const float* noises[2] {};
+    const float* fadeReads[2] {};
+    const float* tapOutputs[2] {};
+    const float* tapSends[2] {};
+    const auto kernelChannels = std::min(numChannels, 2);
+    for (int channel = 0; channel < kernelChannels; ++channel)
+    {
+        inputs[channel] = buffer.getReadPointer(channel, startSample);
+        wets[channel] = getWetBlock(channel);
+        noises[channel] = getNoiseBlock(channel);
+        fadeReads[channel] = getFadeReadBlock(channel);
+        tapOutputs[channel] = getTapOutputBlock(channel);
+        tapSends[channel] = getTapSendBlock(channel);
+    }
+
+    // The mode flags are fixed for the chunk, so the loop runs as the matching specialisation.
+    // The spread of written values per channel tells whether this chunk stored any signal; a
+    // constant offset (the quantizer's idle level) counts as quiet.
+    feedbackModel.setParameters(tone, noiseAmount, numSamples);
+    const DelayKernel::Flags flags { isAuthentic, feedbackModel.hasNoise(), fading, tapping, memoryBuffer.isPacked() };
+    DelayKernel::Spread spread;
+    DelayKernel::select(flags)({ inputs, wets, noises, fadeReads, fadeGainBlock.data(), tapOutputs, tapSends,
+                                 delayBlock.data(), kernelChannels, numSamples, multiTap.getNearTaps(),
+                                 tapping ? multiTap.getNumNearTaps() : 0 },
+                               memoryBuffer, feedbackModel, feedback, spread);
+
+    writeChunkOutput(buffer, startSample, numSamples, kernelChannels, wetBlock.data(), params);
+
+    const auto quiet = spread.getRange(0) <= silenceThreshold && spread.getRange(1) <= silenceThreshold;
+    quietWrittenSamples = quiet ? std::min(maxBufferSamples, quietWrittenSamples + numSamples) : 0;
+}
+
+template <typename SampleType>
+void SixteenSecondAudioProcessor::writeChunkOutput(juce::AudioBuffer<SampleType>& buffer,
+                                                   int startSample,
+                                                   int numSamples,
+                                                   int numChannels,
+                                                   const float* wet,
+                                                   const BlockParameters& params)
+{
+    // Mix, gain and limiter run frame by frame with one channel per lane, so each step covers
+    // every channel at once and the limiter's per-channel envelopes share one register.
+    numChannels = std::min(numChannels, FloatLanes::size);
+    SampleType* outputs[FloatLanes::size] {};
+    const float* wets[FloatLanes::size] {};
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        outputs[channel] = buffer.getWritePointer(channel, startSample);
+        wets[channel] = wet + static_cast<size_t>(channel * renderChunkSize);
+    }
+
+    const auto dryGain = FloatLanes::expand(params.dryGain);
+    const auto wetGain = FloatLanes::expand(params.wetGain);
+    const auto gain = FloatLanes::expand(params.gain);
 
+    for (int i = 0; i < numSamples; ++i)
+    {
+        FloatLanes::Array dry {};
+        FloatLanes::Array wetFrame {};
         for (int channel = 0; channel < numChannels; ++channel)
         {
-            const auto input = buffer.getSample(channel, i);
-            const auto readSample = isAuthentic ? memoryBuffer.readSample(channel, static_cast<int>(readIndex))
-                                                 : memoryBuffer.readSampleLinear(channel, readIndex);
-            const auto feedbackSignal = feedbackModel.process(readSample,
-                                                              filterAmount,
-                                                              noiseAmount,
-                                                              feedback,
-                                                              generateNoise());
-            const auto writeValue = static_cast<float>(input + feedbackSignal);
-            memoryBuffer.writeSample(channel, writeIndex, writeValue);
-            const auto mixed = static_cast<SampleType>(input * dryGain + readSample * wetGain);
-            auto output = static_cast<float>(mixed * gain);
-            if (limiterOn)
-                output = (channel == 0) ? limiterL.process(output) : limiterR.process(output);
-            buffer.setSample(channel, i, static_cast<SampleType>(output));
+            dry[static_cast<size_t>(channel)] = static_cast<float>(outputs[channel][i]);
+            wetFrame[static_cast<size_t>(channel)] = wets[channel][i];
         }
 
-        memoryBuffer.advanceWrite();
+        auto mixed = (FloatLanes::fromArray(dry) * dryGain + FloatLanes::fromArray(wetFrame) * wetGain) * gain;
+        if (params.limiterOn)
+            mixed = limiter.process(mixed);
+
+        const auto out = mixed.toArray();
+        for (int channel = 0; channel < numChannels; ++channel)
+            outputs[channel][i] = static_cast<SampleType>(out[static_cast<size_t>(channel)]);
+    }
+}
+
+LoopView SixteenSecondAudioProcessor::makeLoopView(int channel, int loopStart, int loopLength) const
+{
+    return { memoryBuffer.getReadPointer(channel), memoryBuffer.getSize(), loopStart, loopLength,
+             memoryBuffer.getPackedReadPointer(channel), memoryBuffer.getCodec() };
+}
+
+SampleFormat SixteenSecondAudioProcessor::getStorageFormat() const
+{
+    const auto choice = juce::jlimit(0, 2, static_cast<int>(apvts.getRawParameterValue("storage")->load()));
+    return kStorageFormats[choice];
+}
+
+RateStepper SixteenSecondAudioProcessor::makeDelayHead(float delaySamples) const
+{
+    const auto size = memoryBuffer.getSize();
+    auto position = static_cast<double>(memoryBuffer.getWriteIndex()) - static_cast<double>(delaySamples);
+    position -= std::floor(position / size) * size;
+
+    RateStepper head;
+    head.setLength(size);
+    head.reset(position);
+    head.setRate(1.0);
+    return head;
+}
+
+void SixteenSecondAudioProcessor::beginHeadFade(const RateStepper& previousHead,
+                                                int previousOffset,
+                                                const BlockParameters& params)
+{
+    if (params.isAuthentic || previousHead.getLength() <= 0)
+        return;
+
+    headFade.begin(previousHead, previousOffset, params.headFadeSamples);
+}
+
+bool SixteenSecondAudioProcessor::renderHeadFade(int numChannels, int numSamples, LoopResampler::Quality quality)
+{
+    if (!headFade.isActive())
+        return false;
+
+    auto& head = headFade.getPreviousHead();
+    const auto rate = std::abs(head.getRate());
+    head.fillBlock(fadeIndexBlock.data(), fadeFractionBlock.data(), numSamples);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto loop = makeLoopView(channel, headFade.getPreviousOffset(), head.getLength());
+        loopResampler.process(loop, fadeIndexBlock.data(), fadeFractionBlock.data(), getFadeReadBlock(channel),
+                              numSamples, quality, rate);
     }
+
+    headFade.fillGains(fadeGainBlock.data(), numSamples);
+    return true;
 }
 
-void SixteenSecondAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+void SixteenSecondAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    processBlockInternal(buffer);
+    processBlockInternal(buffer, midiMessages);
+    processedSamples += static_cast<std::uint64_t>(buffer.getNumSamples());
+    runWatchdog(buffer);
     updateMeters(buffer);
+    publishStatus();
 }
 
-void SixteenSecondAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+void SixteenSecondAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    tempFloatBuffer.setSize(buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
-    tempFloatBuffer.clear();
 
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    // The conversion buffer keeps its prepared size; a host exceeding it gets the block in slices.
+    const auto numChannels = std::min(buffer.getNumChannels(), tempFloatBuffer.getNumChannels());
+    const auto numSamples = buffer.getNumSamples();
+    const auto capacity = std::max(1, tempFloatBuffer.getNumSamples());
+
+    for (int start = 0; start < numSamples; start += capacity)
     {
-        auto* src = buffer.getReadPointer(channel);
-        auto* dst = tempFloatBuffer.getWritePointer(channel);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-            dst[i] = static_cast<float>(src[i]);
-    }
+        const auto count = std::min(capacity, numSamples - start);
+        juce::AudioBuffer<float> slice(tempFloatBuffer.getArrayOfWritePointers(), numChannels, count);
 
-    processBlockInternal(tempFloatBuffer);
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* src = buffer.getReadPointer(channel, start);
+            auto* dst = slice.getWritePointer(channel);
+            for (int i = 0; i < count; ++i)
+                dst[i] = static_cast<float>(src[i]);
+        }
 
-    updateMeters(tempFloatBuffer);
+        const auto* midi = &midiMessages;
+        if (count < numSamples)
+        {
+            sliceMidi.clear();
+            sliceMidi.addEvents(midiMessages, start, count, -start);
+            midi = &sliceMidi;
+        }
 
-    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-    {
-        auto* src = tempFloatBuffer.getReadPointer(channel);
-        auto* dst = buffer.getWritePointer(channel);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-            dst[i] = static_cast<double>(src[i]);
+        processBlockInternal(slice, *midi);
+        processedSamples += static_cast<std::uint64_t>(count);
+
+        runWatchdog(slice);
+        updateMeters(slice);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* src = slice.getReadPointer(channel);
+            auto* dst = buffer.getWritePointer(channel, start);
+            for (int i = 0; i < count; ++i)
+                dst[i] = static_cast<double>(src[i]);
+        }
     }
+
+    for (int channel = numChannels; channel < buffer.getNumChannels(); ++channel)
+        buffer.clear(channel, 0, numSamples);
+
+    publishStatus();
 }
 
 void SixteenSecondAudioProcessor::updateMeters(const juce::AudioBuffer<float>& buffer)
@@ -345,24 +959,261 @@ void SixteenSecondAudioProcessor::updateMeters(const juce::AudioBuffer<float>& b
     }
 
     const float decay = 0.90f;
-    const auto newL = std::max(peakL, meterL.load() * decay);
-    const auto newR = std::max(peakR, meterR.load() * decay);
-
-    meterL.store(newL);
-    meterR.store(newR);
+    meterL = std::max(peakL, meterL * decay);
+    meterR = std::max(peakR, meterR * decay);
 
     if (peakL > 1.0f || peakR > 1.0f)
     {
-        clipHold.store(holdSamples);
-        clipFlag.store(true);
+        clipHold = holdSamples;
+        clipFlag = true;
     }
     else
     {
-        auto remaining = clipHold.load();
-        remaining = std::max(0, remaining - numSamples);
-        clipHold.store(remaining);
-        if (remaining == 0)
-            clipFlag.store(false);
+        clipHold = std::max(0, clipHold - numSamples);
+        if (clipHold == 0)
+            clipFlag = false;
+    }
+}
+
+void SixteenSecondAudioProcessor::publishStatus()
+{
+    EngineStatus status;
+    status.state = currentState;
+    status.clip = clipFlag;
+    status.sleeping = sleeping.load(std::memory_order_relaxed);
+    status.reverse = footswitchToggles[static_cast<size_t>(FootswitchAction::Reverse)];
+    status.halfSpeed = footswitchToggles[static_cast<size_t>(FootswitchAction::HalfSpeed)];
+    status.meterL = meterL;
+    status.meterR = meterR;
+    status.sampleRate = memorySampleRate;
+    status.loopLength = loopLengthSamples;
+    status.playhead = status.loopLength > 0 ? loopStepper.getPosition() : 0.0;
+    status.recordedSamples = recordedSamples;
+    status.capacitySamples = maxBufferSamples;
+    status.processedSamples = processedSamples;
+    engineStatus.publish(status);
+}
+
+void SixteenSecondAudioProcessor::addWriteSpan(int start, int length)
+{
+    if (length <= 0)
+        return;
+
+    // Every write is announced here first, so an export in progress saves what it overwrites.
+    loopSnapshot.protect(memoryBuffer, start, length);
+
+    if (numWriteSpans > 0)
+    {
+        auto& last = writeSpans[numWriteSpans - 1];
+        if ((last.start + last.length) % maxBufferSamples == start % maxBufferSamples)
+        {
+            last.length = std::min(maxBufferSamples, last.length + length);
+            return;
+        }
+
+        if ((start + length) % maxBufferSamples == last.start % maxBufferSamples)
+        {
+            last.start = start;
+            last.length = std::min(maxBufferSamples, last.length + length);
+            return;
+        }
+    }
+
+    if (numWriteSpans < maxWriteSpans)
+        writeSpans[numWriteSpans++] = { start, length };
+}
+
+bool SixteenSecondAudioProcessor::resolveFootswitch(const juce::MidiMessage& message, FootswitchAction& action)
+{
+    if (message.isNoteOnOrOff())
+        return footswitchMap.handleEvent(FootswitchBinding::Kind::Note,
+                                         message.getChannel(),
+                                         message.getNoteNumber(),
+                                         message.isNoteOn() ? static_cast<int>(message.getVelocity()) : 0,
+                                         action);
+
+    if (message.isController())
+        return footswitchMap.handleEvent(FootswitchBinding::Kind::Controller,
+                                         message.getChannel(),
+                                         message.getControllerNumber(),
+                                         message.getControllerValue(),
+                                         action);
+
+    return false;
+}
+
+void SixteenSecondAudioProcessor::syncFootswitchToggles()
+{
+    for (size_t i = 0; i < footswitchToggles.size(); ++i)
+    {
+        const auto* parameter = footswitchParameters[i];
+        if (parameter == nullptr)
+            continue;
+
+        // Host/UI changes win; otherwise keep any footswitch toggle until the parameter catches up.
+        const auto paramValue = parameter->load() > 0.5f;
+        if (paramValue != lastParamToggles[i])
+        {
+            lastParamToggles[i] = paramValue;
+            footswitchToggles[i] = paramValue;
+        }
+    }
+}
+
+void SixteenSecondAudioProcessor::toggleFootswitch(FootswitchAction action)
+{
+    const auto index = static_cast<size_t>(action);
+    if (index >= footswitchToggles.size() || kFootswitchParameterIds[index] == nullptr)
+        return;
+
+    setFootswitchToggle(action, !footswitchToggles[index]);
+}
+
+void SixteenSecondAudioProcessor::setFootswitchToggle(FootswitchAction action, bool on)
+{
+    const auto index = static_cast<size_t>(action);
+    if (footswitchToggles[index] == on)
+        return;
+
+    footswitchToggles[index] = on;
+    pendingToggleSync[index].store(on ? 1 : 0);
+}
+
+void SixteenSecondAudioProcessor::applyPresetToggles(const PresetBundle& bundle)
+{
+    // The host parameters follow with the rest of the preset, so nothing is queued for them here,
+    // and a footswitch change still waiting for the timer must not undo the preset afterwards.
+    for (size_t i = 0; i < footswitchToggles.size(); ++i)
+    {
+        if (!bundle.hasToggle[i])
+            continue;
+
+        footswitchToggles[i] = bundle.toggle[i];
+        pendingToggleSync[i].store(-1);
+    }
+}
+
+void SixteenSecondAudioProcessor::flushPresetNotification()
+{
+    const auto program = pendingPresetNotify.exchange(-1);
+    if (program < 0 || program >= getNumPrograms())
+        return;
+
+    const auto generation = presetGeneration.load();
+    for (const auto& [parameter, value] : presets[static_cast<size_t>(program)].bundle->hostValues)
+    {
+        const auto normalised = parameter->convertTo0to1(value);
+        if (parameter->getValue() != normalised)
+            parameter->setValueNotifyingHost(normalised);
+    }
+
+    syncedPresetGeneration.store(generation);
+    updateHostDisplay();
+}
+
+void SixteenSecondAudioProcessor::applyPresetImmediately()
+{
+    flushPresetNotification();
+
+    // The host parameters now hold the preset, so the engine reads them directly.
+    if (const auto* bundle = pendingPreset.exchange(nullptr))
+        applyPresetToggles(*bundle);
+
+    activePreset = nullptr;
+    for (size_t i = 0; i < lastEngineValues.size(); ++i)
+        lastEngineValues[i] = engineParameters[i]->load();
+}
+
+void SixteenSecondAudioProcessor::timerCallback()
+{
+    flushPresetNotification();
+
+    // Storage changes are converted by the provisioner. The callback lock only brackets the
+    // request, so no block is mid-write when the worker starts copying.
+    bufferProvisioner.releaseRetired();
+    const auto storage = getStorageFormat();
+    if (preparedSampleRate > 0.0 && storage != provisionedFormat && !bufferProvisioner.isPending())
+    {
+        provisionedFormat = storage;
+        suspendProcessing(true);
+        bufferProvisioner.request(makeBufferLayout(), makeBufferSource());
+        suspendProcessing(false);
+    }
+
+    for (size_t i = 0; i < pendingToggleSync.size(); ++i)
+    {
+        const auto pending = pendingToggleSync[i].exchange(-1);
+        if (pending < 0)
+            continue;
+
+        if (auto* param = apvts.getParameter(kFootswitchParameterIds[i]))
+        {
+            param->beginChangeGesture();
+            param->setValueNotifyingHost(pending > 0 ? 1.0f : 0.0f);
+            param->endChangeGesture();
+        }
+    }
+}
+
+void SixteenSecondAudioProcessor::addLoopWriteSpan(int loopOffset, int count, bool reverse)
+{
+    count = std::min(count, loopLengthSamples);
+    auto first = reverse ? loopOffset - count + 1 : loopOffset;
+    if (first < 0)
+        first += loopLengthSamples;
+
+    const auto head = std::min(count, loopLengthSamples - first);
+    addWriteSpan(loopStartIndex + first, head);
+    addWriteSpan(loopStartIndex, count - head);
+}
+
+void SixteenSecondAudioProcessor::runWatchdog(juce::AudioBuffer<float>& buffer)
+{
+    const auto numChannels = buffer.getNumChannels();
+    const auto numSamples = buffer.getNumSamples();
+
+    SignalWatchdog::ScanResult outputScan;
+    for (int channel = 0; channel < numChannels; ++channel)
+        outputScan += SignalWatchdog::scan(buffer.getReadPointer(channel), numSamples);
+
+    // Integer storage cannot hold NaN/Inf or denormals, so only float memory is scanned.
+    SignalWatchdog::ScanResult memoryScan;
+    for (int span = 0; span < (memoryBuffer.isPacked() ? 0 : numWriteSpans); ++span)
+    {
+        for (int channel = 0; channel < memoryBuffer.getNumChannels(); ++channel)
+            memoryScan += SignalWatchdog::scanCircular(memoryBuffer.getReadPointer(channel),
+                                                       memoryBuffer.getSize(),
+                                                       writeSpans[span].start,
+                                                       writeSpans[span].length);
+    }
+
+    watchdog.report(outputScan);
+    watchdog.report(memoryScan);
+
+    if (!watchdog.getAutoRecover())
+        return;
+
+    if (outputScan.hasEvents())
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            SignalWatchdog::sanitize(buffer.getWritePointer(channel), numSamples);
+    }
+
+    if (outputScan.hasNonFinite() || memoryScan.hasNonFinite())
+    {
+        for (int span = 0; span < numWriteSpans; ++span)
+        {
+            // Whole pages are cleared, beyond the span that was announced.
+            const auto spanStart = writeSpans[span].start % maxBufferSamples;
+            const auto pageStart = spanStart - spanStart % MemoryBuffer::pageSize;
+            loopSnapshot.protect(memoryBuffer, pageStart,
+                                 spanStart - pageStart + writeSpans[span].length + MemoryBuffer::pageSize);
+            memoryBuffer.clearPages(writeSpans[span].start, writeSpans[span].length);
+        }
+
+        feedbackModel.reset(getSampleRate());
+        limiter.reset(getSampleRate());
+        watchdog.reportRecovery();
     }
 }
 
@@ -379,13 +1230,47 @@ juce::AudioProcessorEditor* SixteenSecondAudioProcessor::createEditor()
 void SixteenSecondAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
     if (auto state = apvts.copyState().createXml())
+    {
+        auto* midi = state->createNewChildElement("MidiFootswitch");
+        for (int i = 0; i < MidiFootswitchMap::numActions; ++i)
+        {
+            const auto binding = footswitchMap.getBinding(static_cast<FootswitchAction>(i));
+            auto* entry = midi->createNewChildElement("Binding");
+            entry->setAttribute("action", i);
+            entry->setAttribute("kind", static_cast<int>(binding.kind));
+            entry->setAttribute("channel", binding.channel);
+            entry->setAttribute("number", binding.number);
+        }
+
         copyXmlToBinary(*state, destData);
+    }
 }
 
 void SixteenSecondAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
     if (auto xmlState = getXmlFromBinary(data, sizeInBytes))
+    {
+        if (auto* midi = xmlState->getChildByName("MidiFootswitch"))
+        {
+            for (auto* entry : midi->getChildIterator())
+            {
+                const auto action = entry->getIntAttribute("action", -1);
+                if (action < 0 || action >= MidiFootswitchMap::numActions)
+                    continue;
+
+                FootswitchBinding binding;
+                binding.kind = static_cast<FootswitchBinding::Kind>(
+                    juce::jlimit(0, 2, entry->getIntAttribute("kind")));
+                binding.channel = juce::jlimit(0, 16, entry->getIntAttribute("channel"));
+                binding.number = juce::jlimit(0, 127, entry->getIntAttribute("number"));
+                footswitchMap.setBinding(static_cast<FootswitchAction>(action), binding);
+            }
+
+            xmlState->removeChildElement(midi, true);
+        }
+
         apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+    }
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SixteenSecondAudioProcessor::createParameterLayout()
@@ -471,6 +1356,18 @@ juce::AudioProcessorValueTreeState::ParameterLayout SixteenSecondAudioProcessor:
         juce::NormalisableRange<float>{0.0f, 1.0f, 0.001f},
         0.6f));
 
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "resonance",
+        "Resonance",
+        juce::NormalisableRange<float>{0.0f, 1.0f, 0.001f},
+        0.0f));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "filterMode",
+        "Filter Mode",
+        juce::StringArray { "Lowpass", "Bandpass", "Highpass" },
+        0));
+
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         "noise",
         "Noise/Grit",
@@ -494,37 +1391,272 @@ juce::AudioProcessorValueTreeState::ParameterLayout SixteenSecondAudioProcessor:
         "Limiter",
         true));
 
+    juce::NormalisableRange<float> speedRange { 0.25f, 2.0f, 0.001f };
+    speedRange.setSkewForCentre(1.0f);
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "speed",
+        "Speed",
+        speedRange,
+        1.0f,
+        "x"));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "hqPlayback",
+        "HQ Playback",
+        true));
+
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        "cleanCapture",
+        "Clean Capture",
+        false));
+
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "storage",
+        "Storage",
+        juce::StringArray { "32-bit float", "16-bit", "12-bit" },
+        0));
+
+    for (int tap = 0; tap < numTaps; ++tap)
+    {
+        const auto name = "Tap " + juce::String(tap + 1);
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            getTapParameterId(tap, "Time"),
+            name + " Time",
+            juce::NormalisableRange<float>{0.0f, 1.0f, 0.001f},
+            kDefaultTapTimes[tap],
+            "x delay"));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            getTapParameterId(tap, "Level"),
+            name + " Level",
+            juce::NormalisableRange<float>{0.0f, 1.0f, 0.001f},
+            0.0f));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            getTapParameterId(tap, "Pan"),
+            name + " Pan",
+            juce::NormalisableRange<float>{-1.0f, 1.0f, 0.001f},
+            kDefaultTapPans[tap]));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            getTapParameterId(tap, "Feedback"),
+            name + " Feedback",
+            juce::NormalisableRange<float>{0.0f, 1.0f, 0.001f},
+            0.0f));
+    }
+
     return {params.begin(), params.end()};
 }
 
 void SixteenSecondAudioProcessor::resetLoopState()
 {
+    loopSnapshot.finish(memoryBuffer);
     memoryBuffer.clear();
     loopLengthSamples = 0;
     loopStartIndex = 0;
     loopReadIndex = 0;
     recordedSamples = 0;
+    loopStepper.setLength(0);
     loopStepper.reset(0.0);
+    headFade.stop();
+    multiTap.reset();
+    quietWrittenSamples = maxBufferSamples;
+    sleepHold.fill(0.0f);
+    lastModOffset = 0.0f;
     delaySmoother.reset(getSampleRate(), 0.0f, 10.0f);
     feedbackModel.reset(getSampleRate());
-    limiterL.reset(getSampleRate());
-    limiterR.reset(getSampleRate());
+    limiter.reset(getSampleRate());
     lfo.reset(getSampleRate());
     currentState = LoopState::Idle;
     lastClear = false;
-    noiseSeed = 0x1234567u;
+    noiseSource.reset();
+}
+
+BufferProvisioner::Layout SixteenSecondAudioProcessor::makeBufferLayout() const
+{
+    const auto maxSeconds = 16.0;
+    return { getTotalNumInputChannels(), static_cast<int>(std::ceil(preparedSampleRate * maxSeconds)),
+             provisionedFormat, preparedSampleRate };
+}
+
+BufferProvisioner::Source SixteenSecondAudioProcessor::makeBufferSource() const
+{
+    return { &memoryBuffer, memorySampleRate, loopStartIndex, loopLengthSamples };
+}
+
+void SixteenSecondAudioProcessor::adoptProvisionedBuffer(const BufferProvisioner::Placement& placement)
+{
+    // An export still copying read from the memory that was just swapped out.
+    loopSnapshot.abandon();
+    if (importing)
+    {
+        importStream.cancel();
+        importing = false;
+    }
+    const auto ratio = memorySampleRate > 0.0 ? placement.sampleRate / memorySampleRate : 1.0;
+    memorySampleRate = placement.sampleRate;
+    maxBufferSamples = memoryBuffer.getSize();
+    recordedSamples = std::min(static_cast<int>(std::lround(recordedSamples * ratio)), placement.written);
+    quietWrittenSamples = placement.written > 0 ? 0 : maxBufferSamples;
+    headFade.stop();
+    multiTap.reset();
+
+    if (placement.loopLength > 0 && loopLengthSamples > 0)
+    {
+        // Keep the playhead at the same point of the loop.
+        const auto phase = loopStepper.getPosition() / static_cast<double>(loopLengthSamples);
+        loopLengthSamples = placement.loopLength;
+        loopStartIndex = placement.loopStart;
+        loopReadIndex = loopStartIndex;
+        loopStepper.setLength(loopLengthSamples);
+        loopStepper.reset(phase * loopLengthSamples);
+        return;
+    }
+
+    loopLengthSamples = 0;
+    loopStartIndex = 0;
+    loopReadIndex = 0;
+    loopStepper.setLength(0);
+    loopStepper.reset(0.0);
+}
+
+void SixteenSecondAudioProcessor::streamImportedLoop()
+{
+    const auto total = importStream.getTotalFrames();
+    if (!importing)
+    {
+        // Converted for other memory than this one: the rate or layout changed since the request.
+        if (importStream.getSampleRate() != memorySampleRate || total > maxBufferSamples
+            || importStream.getNumChannels() != memoryBuffer.getNumChannels())
+        {
+            importStream.cancel();
+            return;
+        }
+
+        // The file is written from the start of memory over whatever was there, old loop included.
+        importing = true;
+        importedFrames = 0;
+        loopLengthSamples = 0;
+        recordedSamples = 0;
+        loopStepper.setLength(0);
+        loopStepper.reset(0.0);
+        setFootswitchToggle(FootswitchAction::Record, false);
+        setFootswitchToggle(FootswitchAction::Overdub, false);
+        currentState = LoopState::Idle;
+    }
+
+    for (int page = 0; page < importPagesPerBlock; ++page)
+    {
+        int frames = 0;
+        const auto* slot = importStream.peek(frames);
+        if (slot == nullptr)
+            break;
+
+        addWriteSpan(importedFrames, frames);
+        for (int channel = 0; channel < memoryBuffer.getNumChannels(); ++channel)
+            memoryBuffer.writeBlock(channel, importedFrames, slot + channel * LoopImportStream::pageSize, frames);
+
+        importStream.pop();
+        importedFrames += frames;
+    }
+
+    if (importedFrames >= total)
+    {
+        adoptImportedLoop(total);
+        importing = false;
+        importStream.complete();
+    }
+}
+
+void SixteenSecondAudioProcessor::adoptImportedLoop(int length)
+{
+    eventTrace.push(processedSamples, TraceEvent::Type::LoopLength, 0, 0.0f, static_cast<float>(length));
+    eventTrace.push(processedSamples, TraceEvent::Type::LoopStart, 0, static_cast<float>(loopStartIndex), 0.0f);
+    eventTrace.push(processedSamples, TraceEvent::Type::StateChange, static_cast<int>(LoopState::Play),
+                    static_cast<float>(currentState), static_cast<float>(LoopState::Play));
+
+    loopStartIndex = 0;
+    loopLengthSamples = length;
+    loopReadIndex = 0;
+    recordedSamples = length;
+    loopStepper.setLength(length);
+    loopStepper.reset(0.0);
+    memoryBuffer.setWriteIndex(length);
+    quietWrittenSamples = 0;
+    headFade.stop();
+    multiTap.reset();
+
+    setFootswitchToggle(FootswitchAction::Play, true);
+    currentState = LoopState::Play;
+}
+
+void SixteenSecondAudioProcessor::traceParameterChanges()
+{
+    for (size_t i = 0; i < tracedParameters.size(); ++i)
+    {
+        auto& param = tracedParameters[i];
+        const auto value = param.value->load();
+        if (value != param.last)
+        {
+            eventTrace.push(processedSamples, TraceEvent::Type::Parameter, static_cast<int>(i), param.last, value);
+            param.last = value;
+        }
+    }
+}
+
+juce::String SixteenSecondAudioProcessor::formatTraceEvent(const TraceEvent& event) const
+{
+    juce::String line;
+    line << juce::String(event.sampleTime) << "\t" << TraceEvent::getTypeName(event.type) << "\t";
+
+    switch (event.type)
+    {
+        case TraceEvent::Type::StateChange:
+            line << getStateName(static_cast<int>(event.previous)) << " -> " << getStateName(event.id);
+            break;
+        case TraceEvent::Type::Parameter:
+            if (event.id >= 0 && event.id < static_cast<int>(tracedParameters.size()))
+                line << tracedParameters[static_cast<size_t>(event.id)].id << "\t";
+            line << juce::String(event.previous) << " -> " << juce::String(event.current);
+            break;
+        case TraceEvent::Type::Footswitch:
+            line << MidiFootswitchMap::getActionName(static_cast<FootswitchAction>(event.id));
+            break;
+        case TraceEvent::Type::ClearEdge:
+        case TraceEvent::Type::LoopLength:
+        case TraceEvent::Type::LoopStart:
+            line << juce::String(event.previous) << " -> " << juce::String(event.current);
+            break;
+    }
+
+    return line;
+}
+
+bool SixteenSecondAudioProcessor::writeEventTrace(const juce::File& file) const
+{
+    std::vector<TraceEvent> events(static_cast<size_t>(EventTrace::capacity));
+    const auto count = eventTrace.copyRecent(events.data(), EventTrace::capacity);
+
+    juce::String text;
+    text << "# 16-Second event trace, sample rate " << juce::String(getSampleRate()) << "\n";
+    for (int i = 0; i < count; ++i)
+        text << formatTraceEvent(events[static_cast<size_t>(i)]) << "\n";
+
+    return file.replaceWithText(text);
 }
 
-void SixteenSecondAudioProcessor::setParamValue(const juce::String& paramId, float value)
+bool SixteenSecondAudioProcessor::importLoop(const juce::File& file)
 {
-    if (auto* param = apvts.getParameter(paramId))
-        param->setValueNotifyingHost(param->convertTo0to1(value));
+    const auto layout = makeBufferLayout();
+    return loopImporter.start(file, layout.channels, layout.size, layout.sampleRate);
 }
 
-void SixteenSecondAudioProcessor::setParamBool(const juce::String& paramId, bool value)
+bool SixteenSecondAudioProcessor::exportLoop(const juce::File& file)
 {
-    if (auto* param = apvts.getParameter(paramId))
-        param->setValueNotifyingHost(value ? 1.0f : 0.0f);
+    // Room for the longest loop the current memory can hold.
+    const auto layout = makeBufferLayout();
+    return loopExporter.start(file, layout.channels, layout.size);
 }
 
 void SixteenSecondAudioProcessor::initializePresets()
@@ -533,140 +1665,203 @@ void SixteenSecondAudioProcessor::initializePresets()
 
     presets.push_back({
         "Unsafe Fripp Wash",
-        [this](juce::AudioProcessorValueTreeState& state)
-        {
-            juce::ignoreUnused(state);
-            setParamValue("delayTime", 9000.0f);
-            setParamValue("feedback", 1.05f);
-            setParamValue("mix", 0.7f);
-            setParamValue("outputGain", -3.0f);
-            setParamValue("modDepth", 0.2f);
-            setParamValue("modSpeed", 0.2f);
-            setParamValue("filter", 0.45f);
-            setParamValue("noise", 0.2f);
-            setParamValue("overdubLevel", 0.5f);
-            setParamValue("erodeAmount", 0.25f);
-            setParamBool("reverse", false);
-            setParamBool("halfSpeed", false);
-            setParamBool("authentic", true);
-            setParamBool("limiter", true);
-            setParamBool("record", false);
-            setParamBool("play", false);
-            setParamBool("overdub", false);
-            setParamBool("clear", false);
-        }
+        {
+            { "delayTime", 9000.0f },
+            { "feedback", 1.05f },
+            { "mix", 0.7f },
+            { "outputGain", -3.0f },
+            { "modDepth", 0.2f },
+            { "modSpeed", 0.2f },
+            { "filter", 0.45f },
+            { "noise", 0.2f },
+            { "resonance", 0.0f },
+            { "filterMode", 0.0f },
+            { "overdubLevel", 0.5f },
+            { "speed", 1.0f },
+            { "erodeAmount", 0.25f },
+            { "tap1Level", 0.0f },
+            { "tap2Level", 0.0f },
+            { "tap3Level", 0.0f },
+            { "tap4Level", 0.0f },
+            { "reverse", 0.0f },
+            { "halfSpeed", 0.0f },
+            { "authentic", 1.0f },
+            { "limiter", 1.0f },
+            { "hqPlayback", 1.0f },
+            { "cleanCapture", 0.0f },
+            { "record", 0.0f },
+            { "play", 0.0f },
+            { "overdub", 0.0f },
+            { "clear", 0.0f },
+        },
+        nullptr
     });
 
     presets.push_back({
         "Clock Tear",
-        [this](juce::AudioProcessorValueTreeState& state)
-        {
-            juce::ignoreUnused(state);
-            setParamValue("delayTime", 1200.0f);
-            setParamValue("feedback", 0.8f);
-            setParamValue("mix", 0.5f);
-            setParamValue("outputGain", 0.0f);
-            setParamValue("modDepth", 0.6f);
-            setParamValue("modSpeed", 0.7f);
-            setParamValue("filter", 0.7f);
-            setParamValue("noise", 0.35f);
-            setParamValue("overdubLevel", 0.5f);
-            setParamValue("erodeAmount", 0.4f);
-            setParamBool("reverse", false);
-            setParamBool("halfSpeed", false);
-            setParamBool("authentic", true);
-            setParamBool("limiter", true);
-            setParamBool("record", false);
-            setParamBool("play", false);
-            setParamBool("overdub", false);
-            setParamBool("clear", false);
-        }
+        {
+            { "delayTime", 1200.0f },
+            { "feedback", 0.8f },
+            { "mix", 0.5f },
+            { "outputGain", 0.0f },
+            { "modDepth", 0.6f },
+            { "modSpeed", 0.7f },
+            { "filter", 0.7f },
+            { "noise", 0.35f },
+            { "resonance", 0.0f },
+            { "filterMode", 0.0f },
+            { "overdubLevel", 0.5f },
+            { "speed", 1.0f },
+            { "erodeAmount", 0.4f },
+            { "tap1Level", 0.0f },
+            { "tap2Level", 0.0f },
+            { "tap3Level", 0.0f },
+            { "tap4Level", 0.0f },
+            { "reverse", 0.0f },
+            { "halfSpeed", 0.0f },
+            { "authentic", 1.0f },
+            { "limiter", 1.0f },
+            { "hqPlayback", 1.0f },
+            { "cleanCapture", 0.0f },
+            { "record", 0.0f },
+            { "play", 0.0f },
+            { "overdub", 0.0f },
+            { "clear", 0.0f },
+        },
+        nullptr
     });
 
     presets.push_back({
         "Half-speed Ghosts",
-        [this](juce::AudioProcessorValueTreeState& state)
-        {
-            juce::ignoreUnused(state);
-            setParamValue("delayTime", 8000.0f);
-            setParamValue("feedback", 0.75f);
-            setParamValue("mix", 0.6f);
-            setParamValue("outputGain", -2.0f);
-            setParamValue("modDepth", 0.1f);
-            setParamValue("modSpeed", 0.1f);
-            setParamValue("filter", 0.5f);
-            setParamValue("noise", 0.15f);
-            setParamValue("overdubLevel", 0.5f);
-            setParamValue("erodeAmount", 0.3f);
-            setParamBool("reverse", false);
-            setParamBool("halfSpeed", true);
-            setParamBool("authentic", false);
-            setParamBool("limiter", true);
-            setParamBool("record", false);
-            setParamBool("play", false);
-            setParamBool("overdub", false);
-            setParamBool("clear", false);
-        }
+        {
+            { "delayTime", 8000.0f },
+            { "feedback", 0.75f },
+            { "mix", 0.6f },
+            { "outputGain", -2.0f },
+            { "modDepth", 0.1f },
+            { "modSpeed", 0.1f },
+            { "filter", 0.5f },
+            { "noise", 0.15f },
+            { "resonance", 0.0f },
+            { "filterMode", 0.0f },
+            { "overdubLevel", 0.5f },
+            { "speed", 1.0f },
+            { "erodeAmount", 0.3f },
+            { "tap1Level", 0.0f },
+            { "tap2Level", 0.0f },
+            { "tap3Level", 0.0f },
+            { "tap4Level", 0.0f },
+            { "reverse", 0.0f },
+            { "halfSpeed", 1.0f },
+            { "authentic", 0.0f },
+            { "limiter", 1.0f },
+            { "hqPlayback", 1.0f },
+            { "cleanCapture", 0.0f },
+            { "record", 0.0f },
+            { "play", 0.0f },
+            { "overdub", 0.0f },
+            { "clear", 0.0f },
+        },
+        nullptr
     });
 
     presets.push_back({
         "Reverse Smear",
-        [this](juce::AudioProcessorValueTreeState& state)
-        {
-            juce::ignoreUnused(state);
-            setParamValue("delayTime", 5000.0f);
-            setParamValue("feedback", 0.7f);
-            setParamValue("mix", 0.55f);
-            setParamValue("outputGain", -1.0f);
-            setParamValue("modDepth", 0.25f);
-            setParamValue("modSpeed", 0.3f);
-            setParamValue("filter", 0.55f);
-            setParamValue("noise", 0.2f);
-            setParamValue("overdubLevel", 0.5f);
-            setParamValue("erodeAmount", 0.35f);
-            setParamBool("reverse", true);
-            setParamBool("halfSpeed", false);
-            setParamBool("authentic", false);
-            setParamBool("limiter", true);
-            setParamBool("record", false);
-            setParamBool("play", false);
-            setParamBool("overdub", false);
-            setParamBool("clear", false);
-        }
+        {
+            { "delayTime", 5000.0f },
+            { "feedback", 0.7f },
+            { "mix", 0.55f },
+            { "outputGain", -1.0f },
+            { "modDepth", 0.25f },
+            { "modSpeed", 0.3f },
+            { "filter", 0.55f },
+            { "noise", 0.2f },
+            { "resonance", 0.0f },
+            { "filterMode", 0.0f },
+            { "overdubLevel", 0.5f },
+            { "speed", 1.0f },
+            { "erodeAmount", 0.35f },
+            { "tap1Level", 0.0f },
+            { "tap2Level", 0.0f },
+            { "tap3Level", 0.0f },
+            { "tap4Level", 0.0f },
+            { "reverse", 1.0f },
+            { "halfSpeed", 0.0f },
+            { "authentic", 0.0f },
+            { "limiter", 1.0f },
+            { "hqPlayback", 1.0f },
+            { "cleanCapture", 0.0f },
+            { "record", 0.0f },
+            { "play", 0.0f },
+            { "overdub", 0.0f },
+            { "clear", 0.0f },
+        },
+        nullptr
     });
 
     presets.push_back({
         "Erode Drone",
-        [this](juce::AudioProcessorValueTreeState& state)
-        {
-            juce::ignoreUnused(state);
-            setParamValue("delayTime", 12000.0f);
-            setParamValue("feedback", 0.95f);
-            setParamValue("mix", 0.8f);
-            setParamValue("outputGain", -4.0f);
-            setParamValue("modDepth", 0.35f);
-            setParamValue("modSpeed", 0.15f);
-            setParamValue("filter", 0.35f);
-            setParamValue("noise", 0.45f);
-            setParamValue("overdubLevel", 0.8f);
-            setParamValue("erodeAmount", 0.7f);
-            setParamBool("reverse", false);
-            setParamBool("halfSpeed", false);
-            setParamBool("authentic", true);
-            setParamBool("limiter", true);
-            setParamBool("record", false);
-            setParamBool("play", false);
-            setParamBool("overdub", false);
-            setParamBool("clear", false);
-        }
+        {
+            { "delayTime", 12000.0f },
+            { "feedback", 0.95f },
+            { "mix", 0.8f },
+            { "outputGain", -4.0f },
+            { "modDepth", 0.35f },
+            { "modSpeed", 0.15f },
+            { "filter", 0.35f },
+            { "noise", 0.45f },
+            { "resonance", 0.0f },
+            { "filterMode", 0.0f },
+            { "overdubLevel", 0.8f },
+            { "speed", 1.0f },
+            { "erodeAmount", 0.7f },
+            { "tap1Level", 0.0f },
+            { "tap2Level", 0.0f },
+            { "tap3Level", 0.0f },
+            { "tap4Level", 0.0f },
+            { "reverse", 0.0f },
+            { "halfSpeed", 0.0f },
+            { "authentic", 1.0f },
+            { "limiter", 1.0f },
+            { "hqPlayback", 1.0f },
+            { "cleanCapture", 0.0f },
+            { "record", 0.0f },
+            { "play", 0.0f },
+            { "overdub", 0.0f },
+            { "clear", 0.0f },
+        },
+        nullptr
     });
-}
 
-float SixteenSecondAudioProcessor::generateNoise()
-{
-    noiseSeed = noiseSeed * 1664525u + 1013904223u;
-    const auto value = static_cast<float>((noiseSeed >> 8) & 0x00FFFFFFu) / 16777215.0f;
-    return value;
+    for (auto& preset : presets)
+    {
+        preset.bundle = std::make_unique<PresetBundle>();
+        for (const auto& [id, value] : preset.values)
+        {
+            auto* parameter = apvts.getParameter(id);
+            if (parameter == nullptr)
+                continue;
+
+            preset.bundle->hostValues.emplace_back(parameter, value);
+            for (size_t i = 0; i < preset.bundle->engine.size(); ++i)
+            {
+                if (std::strcmp(kEngineParameterIds[i], id) == 0)
+                {
+                    preset.bundle->engine[i] = value;
+                    preset.bundle->hasEngineValue[i] = true;
+                }
+            }
+
+            for (size_t i = 0; i < preset.bundle->toggle.size(); ++i)
+            {
+                if (kFootswitchParameterIds[i] != nullptr && std::strcmp(kFootswitchParameterIds[i], id) == 0)
+                {
+                    preset.bundle->toggle[i] = value > 0.5f;
+                    preset.bundle->hasToggle[i] = true;
+                }
+            }
+        }
+    }
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 
 #include "dsp/MemoryBuffer.h"
+#include "dsp/BufferProvisioner.h"
 #include "dsp/Overdub.h"
 #include "dsp/RateStepper.h"
 #include "dsp/StateMachine.h"
@@ -10,12 +11,27 @@
 #include "dsp/FeedbackModel.h"
 #include "dsp/Limiter.h"
 #include "dsp/LFO.h"
+#include "dsp/SignalWatchdog.h"
+#include "dsp/EventTrace.h"
+#include "dsp/MidiFootswitch.h"
+#include "dsp/NoiseSource.h"
+#include "dsp/LoopResampler.h"
+#include "dsp/ReadHeadCrossfader.h"
+#include "dsp/MultiTap.h"
+#include "dsp/DelayKernel.h"
+#include "dsp/EngineStatus.h"
+#include "dsp/LoopSnapshot.h"
+#include "dsp/LoopImportStream.h"
+#include "LoopExporter.h"
+#include "LoopImporter.h"
+#include <array>
 #include <cstdint>
 #include <atomic>
-#include <functional>
+#include <memory>
 #include <vector>
 
-class SixteenSecondAudioProcessor final : public juce::AudioProcessor
+class SixteenSecondAudioProcessor final : public juce::AudioProcessor,
+                                          private juce::Timer
 {
 public:
     SixteenSecondAudioProcessor();
@@ -49,40 +65,267 @@ public:
     void setStateInformation(const void* data, int sizeInBytes) override;
 
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
+    SignalWatchdog& getWatchdog() { return watchdog; }
+    EventTrace& getEventTrace() { return eventTrace; }
+    MidiFootswitchMap& getFootswitchMap() { return footswitchMap; }
+    bool isSleeping() const { return sleeping.load(); }
+    // One consistent snapshot of the engine as of the last block; false if none could be read.
+    bool getEngineStatus(EngineStatus& status) const { return engineStatus.read(status); }
+    juce::String formatTraceEvent(const TraceEvent& event) const;
+    bool writeEventTrace(const juce::File& file) const;
+    // Starts writing the current loop to `file` in the background; false while one is running.
+    bool exportLoop(const juce::File& file);
+    LoopExporter::Status getExportStatus() const { return loopExporter.getStatus(); }
+    // Loads `file` as the loop in the background and starts playing it; false while one is loading.
+    bool importLoop(const juce::File& file);
+    LoopImporter::Status getImportStatus() const { return loopImporter.getStatus(); }
+    // Pushes the last selected preset's values to the host parameters (normally from the timer).
+    void flushPresetNotification();
+    // Offline renders, before playback: pushes the selected preset to the host parameters and
+    // drops the engine's ramp to it, so values set afterwards are heard from the first sample.
+    void applyPresetImmediately();
 
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
 private:
+    static constexpr int numTaps = 4;
+
+    // Every parameter the engine reads per block; taps follow as Time, Level, Pan, Feedback.
+    enum EngineParameter
+    {
+        DelayTime,
+        Feedback,
+        Mix,
+        OverdubLevel,
+        ErodeAmount,
+        Filter,
+        Resonance,
+        Noise,
+        ModDepth,
+        ModSpeed,
+        OutputGain,
+        Speed,
+        LimiterOn,
+        Authentic,
+        HqPlayback,
+        CleanCapture,
+        FilterMode,
+        FirstTapParameter,
+        numEngineParameters = FirstTapParameter + numTaps * 4
+    };
+
+    using EngineValues = std::array<float, numEngineParameters>;
+
+    // A preset compiled once: the engine side is published to the audio thread with a single
+    // pointer swap, the host side is applied later from the message thread in one batch.
+    // Transport and direction switches are engine values too, so they land in the same block.
+    struct PresetBundle
+    {
+        EngineValues engine {};
+        std::array<bool, numEngineParameters> hasEngineValue {};
+        std::array<bool, MidiFootswitchMap::numActions> toggle {};
+        std::array<bool, MidiFootswitchMap::numActions> hasToggle {};
+        std::vector<std::pair<juce::RangedAudioParameter*, float>> hostValues;
+    };
+
     struct Preset
     {
         juce::String name;
-        std::function<void(juce::AudioProcessorValueTreeState&)> apply;
+        std::vector<std::pair<const char*, float>> values;
+        std::unique_ptr<PresetBundle> bundle;
     };
 
-    void setParamValue(const juce::String& paramId, float value);
-    void setParamBool(const juce::String& paramId, bool value);
     void initializePresets();
+    void pullEngineValues(EngineValues& values, int numSamples);
 
     juce::AudioProcessorValueTreeState apvts;
     std::vector<Preset> presets;
     int currentProgram = 0;
 
+    struct BlockParameters
+    {
+        float delayMs = 0.0f;
+        float feedback = 0.0f;
+        float overdubLevel = 0.0f;
+        float erodeAmount = 0.0f;
+        FeedbackModel::Tone tone;
+        float noiseAmount = 0.0f;
+        float gain = 1.0f;
+        float dryGain = 1.0f;
+        float wetGain = 0.0f;
+        float modDepthSamples = 0.0f;
+        float speed = 1.0f;
+        int targetDelaySamples = 0;
+        int rateRampSamples = 0;
+        int headFadeSamples = 0;
+        std::array<float, numTaps> tapTimes {};
+        bool limiterOn = true;
+        bool isAuthentic = false;
+        bool hqPlayback = true;
+        bool cleanCapture = false;
+    };
+
+    template <typename SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>& buffer, const juce::MidiBuffer& midiMessages);
+
+    template <typename SampleType>
+    bool canSleep(const juce::AudioBuffer<SampleType>& buffer,
+                  const juce::MidiBuffer& midiMessages,
+                  const BlockParameters& params,
+                  bool clearEdge) const;
+
+    template <typename SampleType>
+    void processSegment(juce::AudioBuffer<SampleType>& buffer,
+                        int startSample,
+                        int numSamples,
+                        const BlockParameters& params,
+                        bool clearEdge);
+
+    template <typename SampleType>
+    void renderChunk(juce::AudioBuffer<SampleType>& buffer,
+                     int startSample,
+                     int numSamples,
+                     const BlockParameters& params);
+
+    // Dry/wet mix, output gain and limiter for one chunk; wet is laid out like the other chunk blocks.
     template <typename SampleType>
-    void processBlockInternal(juce::AudioBuffer<SampleType>& buffer);
+    void writeChunkOutput(juce::AudioBuffer<SampleType>& buffer,
+                          int startSample,
+                          int numSamples,
+                          int numChannels,
+                          const float* wet,
+                          const BlockParameters& params);
+
+    float* getNoiseBlock(int channel) { return noiseBlock.data() + static_cast<size_t>(channel * renderChunkSize); }
+    float* getCaptureBlock(int channel) { return captureBlock.data() + static_cast<size_t>(channel * renderChunkSize); }
+    float* getReadBlock(int channel) { return readBlock.data() + static_cast<size_t>(channel * renderChunkSize); }
+    float* getTapOutputBlock(int channel) { return tapOutputBlock.data() + static_cast<size_t>(channel * renderChunkSize); }
+    float* getTapSendBlock(int channel) { return tapSendBlock.data() + static_cast<size_t>(channel * renderChunkSize); }
+    float* getFadeReadBlock(int channel) { return fadeReadBlock.data() + static_cast<size_t>(channel * renderChunkSize); }
+    float* getWetBlock(int channel) { return wetBlock.data() + static_cast<size_t>(channel * renderChunkSize); }
+
+    LoopView makeLoopView(int channel, int loopStart, int loopLength) const;
+    SampleFormat getStorageFormat() const;
+    RateStepper makeDelayHead(float delaySamples) const;
+    void beginHeadFade(const RateStepper& previousHead, int previousOffset, const BlockParameters& params);
+    bool renderHeadFade(int numChannels, int numSamples, LoopResampler::Quality quality);
+
+    bool resolveFootswitch(const juce::MidiMessage& message, FootswitchAction& action);
+    void syncFootswitchToggles();
+    void toggleFootswitch(FootswitchAction action);
+    void setFootswitchToggle(FootswitchAction action, bool on);
+    void applyPresetToggles(const PresetBundle& bundle);
+    void timerCallback() override;
 
     void resetLoopState();
-    float generateNoise();
+    BufferProvisioner::Layout makeBufferLayout() const;
+    BufferProvisioner::Source makeBufferSource() const;
+    void adoptProvisionedBuffer(const BufferProvisioner::Placement& placement);
+    void streamImportedLoop();
+    void adoptImportedLoop(int length);
+    void traceParameterChanges();
     void updateMeters(const juce::AudioBuffer<float>& buffer);
+    void publishStatus();
+    void runWatchdog(juce::AudioBuffer<float>& buffer);
+    void addWriteSpan(int start, int length);
+    void addLoopWriteSpan(int loopOffset, int count, bool reverse);
 
     MemoryBuffer memoryBuffer;
+    // Declared after memoryBuffer: its worker may still be reading it during destruction.
+    BufferProvisioner bufferProvisioner;
+    // Loop pages copied for an export at the start of each block, besides copy-on-write.
+    static constexpr int snapshotPagesPerBlock = 4;
+    LoopSnapshot loopSnapshot;
+    LoopExporter loopExporter { loopSnapshot };
+    // Imported pages written into memory per block while a file streams in.
+    static constexpr int importPagesPerBlock = 4;
+    LoopImportStream importStream;
+    LoopImporter loopImporter { importStream };
+    bool importing = false;
+    int importedFrames = 0;
+    double preparedSampleRate = 0.0;
+    // Rate the content of memoryBuffer was recorded at; lags preparedSampleRate until the swap.
+    double memorySampleRate = 0.0;
+    int preparedChannels = -1;
+    SampleFormat provisionedFormat = SampleFormat::Float32;
     StateMachine stateMachine;
     RateStepper loopStepper;
     Smoother delaySmoother;
     FeedbackModel feedbackModel;
-    Limiter limiterL;
-    Limiter limiterR;
+    Limiter limiter;
     LFO lfo;
+    NoiseSource noiseSource;
+    static constexpr int renderChunkSize = 256;
+    std::vector<float> noiseBlock;
+    std::vector<int> readIndexBlock;
+    std::vector<float> readFractionBlock;
+    std::vector<float> readBlock;
+    std::vector<int> overdubIndexBlock;
+    std::vector<float> captureBlock;
+    Overdub::Gains overdubGains;
+    LoopResampler loopResampler;
+    ReadHeadCrossfader headFade;
+    MultiTap multiTap;
+    std::vector<float> tapOutputBlock;
+    std::vector<float> tapSendBlock;
+    std::vector<int> fadeIndexBlock;
+    std::vector<float> fadeFractionBlock;
+    std::vector<float> fadeGainBlock;
+    std::vector<float> fadeReadBlock;
+    std::vector<float> delayBlock;
+    std::vector<float> wetBlock;
+    float lastModOffset = 0.0f;
+    SignalWatchdog watchdog;
+    EventTrace eventTrace;
     juce::AudioBuffer<float> tempFloatBuffer;
+    // Footswitch events of one slice when a double-precision block exceeds the prepared size.
+    juce::MidiBuffer sliceMidi;
+
+    struct WriteSpan
+    {
+        int start = 0;
+        int length = 0;
+    };
+
+    static constexpr int maxWriteSpans = 8;
+    WriteSpan writeSpans[maxWriteSpans];
+    int numWriteSpans = 0;
+
+    MidiFootswitchMap footswitchMap;
+    std::array<bool, MidiFootswitchMap::numActions> footswitchToggles {};
+    std::array<bool, MidiFootswitchMap::numActions> lastParamToggles {};
+    std::array<std::atomic<int>, MidiFootswitchMap::numActions> pendingToggleSync;
+    // Resolved once in the constructor; the audio thread never looks parameters up by ID.
+    std::array<std::atomic<float>*, MidiFootswitchMap::numActions> footswitchParameters {};
+    std::atomic<float>* clearParameter = nullptr;
+
+    struct TracedParameter
+    {
+        const char* id = nullptr;
+        std::atomic<float>* value = nullptr;
+        float last = 0.0f;
+    };
+
+    std::vector<TracedParameter> tracedParameters;
+
+    std::array<std::atomic<float>*, numEngineParameters> engineParameters {};
+    EngineValues lastEngineValues {};
+    EngineValues presetRampStart {};
+    const PresetBundle* activePreset = nullptr;
+    std::uint64_t activePresetGeneration = 0;
+    int presetRampPosition = 0;
+    std::atomic<const PresetBundle*> pendingPreset { nullptr };
+    std::atomic<std::uint64_t> presetGeneration { 0 };
+    std::atomic<std::uint64_t> syncedPresetGeneration { 0 };
+    std::atomic<int> pendingPresetNotify { -1 };
+    std::uint64_t processedSamples = 0;
+
+    // Level below which input and buffer content count as silent (-80 dB).
+    static constexpr float silenceThreshold = 1.0e-4f;
+    // How many samples behind the write head are known to hold no signal (only a steady offset).
+    int quietWrittenSamples = 0;
+    std::array<float, 2> sleepHold {};
+    std::atomic<bool> sleeping { false };
 
     int maxBufferSamples = 0;
     int loopLengthSamples = 0;
@@ -91,18 +334,13 @@ private:
     int recordedSamples = 0;
     LoopState currentState = LoopState::Idle;
     bool lastClear = false;
-    std::uint32_t noiseSeed = 0x1234567u;
-
-public:
-    float getMeterL() const { return meterL.load(); }
-    float getMeterR() const { return meterR.load(); }
-    bool getClip() const { return clipFlag.load(); }
 
-private:
-    std::atomic<float> meterL { 0.0f };
-    std::atomic<float> meterR { 0.0f };
-    std::atomic<bool> clipFlag { false };
-    std::atomic<int> clipHold { 0 };
+    // Meter state lives on the audio thread; the editor sees it through engineStatus.
+    float meterL = 0.0f;
+    float meterR = 0.0f;
+    bool clipFlag = false;
+    int clipHold = 0;
+    EngineStatusChannel engineStatus;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SixteenSecondAudioProcessor)
 };
@@ -0,0 +1,202 @@
+#include "BatchRenderer.h"
+
+#include "../PluginProcessor.h"
+
+#include <algorithm>
+
+namespace
+{
+    bool applyPreset(SixteenSecondAudioProcessor& processor, const juce::String& preset)
+    {
+        if (preset.isEmpty())
+            return true;
+
+        auto index = -1;
+        for (int i = 0; i < processor.getNumPrograms() && index < 0; ++i)
+        {
+            if (processor.getProgramName(i).equalsIgnoreCase(preset))
+                index = i;
+        }
+
+        if (index < 0 && preset.containsOnly("0123456789") && preset.getIntValue() < processor.getNumPrograms())
+            index = preset.getIntValue();
+
+        if (index < 0)
+            return false;
+
+        // Straight into the parameters, so the job's own values override the preset from the start.
+        processor.setCurrentProgram(index);
+        processor.applyPresetImmediately();
+        return true;
+    }
+
+    struct ScheduledChange
+    {
+        juce::int64 sample = 0;
+        juce::RangedAudioParameter* parameter = nullptr;
+        float value = 0.0f;
+    };
+}
+
+bool BatchRenderer::parseJob(const juce::String& line, const juce::File& baseDirectory, RenderJob& job, juce::String& error)
+{
+    job = {};
+
+    for (auto token : juce::StringArray::fromTokens(line, " \t", "\""))
+    {
+        token = token.unquoted();
+        const auto key = token.upToFirstOccurrenceOf("=", false, false).trim();
+        const auto value = token.fromFirstOccurrenceOf("=", false, false).trim().unquoted();
+
+        if (key.isEmpty() || !token.containsChar('='))
+        {
+            error = "expected key=value, got '" + token + "'";
+            return false;
+        }
+
+        if (key == "in")
+            job.input = baseDirectory.getChildFile(value);
+        else if (key == "out")
+            job.output = baseDirectory.getChildFile(value);
+        else if (key == "preset")
+            job.preset = value;
+        else if (key == "tail")
+            job.tailSeconds = std::max(0.0, value.getDoubleValue());
+        else if (key.containsChar('@'))
+            job.changes.push_back({ std::max(0.0, key.fromFirstOccurrenceOf("@", false, false).getDoubleValue()),
+                                    key.upToFirstOccurrenceOf("@", false, false), value.getFloatValue() });
+        else
+            job.changes.push_back({ 0.0, key, value.getFloatValue() });
+    }
+
+    if (job.input == juce::File() || job.output == juce::File())
+    {
+        error = "job needs in= and out=";
+        return false;
+    }
+
+    std::stable_sort(job.changes.begin(), job.changes.end(),
+                     [](const RenderJob::ParameterChange& a, const RenderJob::ParameterChange& b)
+                     { return a.seconds < b.seconds; });
+    return true;
+}
+
+RenderResult BatchRenderer::render(const RenderJob& job, int blockSize, int chunkSize)
+{
+    RenderResult result;
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(job.input));
+    if (reader == nullptr)
+    {
+        result.error = "cannot read " + job.input.getFullPathName();
+        return result;
+    }
+
+    const auto sampleRate = reader->sampleRate;
+    const auto outputChannels = juce::jlimit(1, 2, static_cast<int>(reader->numChannels));
+
+    job.output.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream(job.output.createOutputStream());
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        stream != nullptr ? wav.createWriterFor(stream.get(), sampleRate, static_cast<unsigned int>(outputChannels),
+                                                24, {}, 0)
+                          : nullptr);
+    if (writer == nullptr)
+    {
+        result.error = "cannot write " + job.output.getFullPathName();
+        return result;
+    }
+    stream.release();
+
+    SixteenSecondAudioProcessor processor;
+    auto& state = processor.getAPVTS();
+    if (!applyPreset(processor, job.preset))
+    {
+        result.error = "unknown preset '" + job.preset + "'";
+        return result;
+    }
+
+    std::vector<ScheduledChange> schedule;
+    for (const auto& change : job.changes)
+    {
+        auto* parameter = state.getParameter(change.parameterId);
+        if (parameter == nullptr)
+        {
+            result.error = "unknown parameter '" + change.parameterId + "'";
+            return result;
+        }
+        schedule.push_back({ static_cast<juce::int64>(change.seconds * sampleRate), parameter, change.value });
+    }
+
+    // Values set up front are in place before prepareToPlay, so nothing ramps to them.
+    size_t nextChange = 0;
+    for (; nextChange < schedule.size() && schedule[nextChange].sample <= 0; ++nextChange)
+    {
+        auto& change = schedule[nextChange];
+        change.parameter->setValueNotifyingHost(change.parameter->convertTo0to1(change.value));
+    }
+
+    blockSize = std::max(1, blockSize);
+    chunkSize = std::max(blockSize, chunkSize);
+    processor.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+    // Offline, so prepareToPlay waits for the delay memory instead of passing the first blocks dry.
+    processor.setNonRealtime(true);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    const auto inputLength = reader->lengthInSamples;
+    const auto totalLength = inputLength + static_cast<juce::int64>(job.tailSeconds * sampleRate);
+    juce::AudioBuffer<float> chunk(2, chunkSize);
+    juce::MidiBuffer midi;
+
+    for (juce::int64 position = 0; position < totalLength;)
+    {
+        const auto numSamples = static_cast<int>(std::min<juce::int64>(chunkSize, totalLength - position));
+        chunk.clear();
+
+        const auto toRead = static_cast<int>(std::max<juce::int64>(0, std::min<juce::int64>(numSamples, inputLength - position)));
+        if (toRead > 0)
+        {
+            reader->read(&chunk, 0, toRead, position, true, true);
+            if (reader->numChannels == 1)
+                chunk.copyFrom(1, 0, chunk, 0, 0, toRead);
+        }
+
+        for (int offset = 0; offset < numSamples;)
+        {
+            const auto now = position + offset;
+            for (; nextChange < schedule.size() && schedule[nextChange].sample <= now; ++nextChange)
+            {
+                auto& change = schedule[nextChange];
+                change.parameter->setValueNotifyingHost(change.parameter->convertTo0to1(change.value));
+            }
+
+            auto end = std::min(numSamples, offset + blockSize);
+            if (nextChange < schedule.size() && schedule[nextChange].sample < position + end)
+                end = static_cast<int>(schedule[nextChange].sample - position);
+
+            juce::AudioBuffer<float> block(chunk.getArrayOfWritePointers(), 2, offset, end - offset);
+            processor.processBlock(block, midi);
+            offset = end;
+        }
+
+        writer->writeFromAudioSampleBuffer(chunk, 0, numSamples);
+        position += numSamples;
+    }
+
+    processor.releaseResources();
+    writer.reset();
+
+    const auto& watchdog = processor.getWatchdog();
+    result.nanCount = watchdog.getNanCount();
+    result.infCount = watchdog.getInfCount();
+    result.denormalCount = watchdog.getDenormalCount();
+    result.recoveryCount = watchdog.getRecoveryCount();
+    result.audioSeconds = static_cast<double>(totalLength) / sampleRate;
+    result.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    result.ok = true;
+    return result;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <cstdint>
+#include <vector>
+
+// One stem to reprint: input file, output file, preset, and parameter values that are either set
+// up front (`id=value`) or stepped at a time in seconds (`id@seconds=value`).
+struct RenderJob
+{
+    struct ParameterChange
+    {
+        double seconds = 0.0;
+        juce::String parameterId;
+        float value = 0.0f;
+    };
+
+    juce::File input;
+    juce::File output;
+    juce::String preset;
+    std::vector<ParameterChange> changes;
+    double tailSeconds = 0.0;
+};
+
+struct RenderResult
+{
+    bool ok = false;
+    juce::String error;
+    double audioSeconds = 0.0;
+    double wallSeconds = 0.0;
+    std::uint64_t nanCount = 0;
+    std::uint64_t infCount = 0;
+    std::uint64_t denormalCount = 0;
+    std::uint64_t recoveryCount = 0;
+
+    double getRealtimeFactor() const { return wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0; }
+};
+
+class BatchRenderer
+{
+public:
+    // Parses one job line: whitespace-separated tokens, double quotes around values with spaces.
+    // Relative paths resolve against baseDirectory.
+    static bool parseJob(const juce::String& line, const juce::File& baseDirectory, RenderJob& job, juce::String& error);
+
+    // Renders a job on the calling thread with its own processor instance. Audio is read and
+    // written chunkSize samples at a time and fed to the processor in blockSize host blocks,
+    // split at automation points.
+    static RenderResult render(const RenderJob& job, int blockSize, int chunkSize);
+};
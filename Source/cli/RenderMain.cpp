@@ -0,0 +1,155 @@
+#include <JuceHeader.h>
+
+#include "BatchRenderer.h"
+#include "WorkStealingPool.h"
+
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: 16SecondRender [--threads N] [--block N] [--chunk N] [--job \"spec\"]... [jobfile]...\n"
+                     "\n"
+                     "Each job (one per line in a job file, '#' starts a comment) is a list of tokens:\n"
+                     "  in=<file> out=<file.wav>   input and output (required)\n"
+                     "  preset=<name|index>        starting preset\n"
+                     "  <param>=<value>            parameter value at the start\n"
+                     "  <param>@<seconds>=<value>  parameter change at a time (e.g. play@4=1)\n"
+                     "  tail=<seconds>             extra render after the input ends\n";
+    }
+
+    bool readJobFile(const juce::File& file, std::vector<RenderJob>& jobs)
+    {
+        if (!file.existsAsFile())
+        {
+            std::cerr << "Job file not found: " << file.getFullPathName() << "\n";
+            return false;
+        }
+
+        juce::StringArray lines;
+        file.readLines(lines);
+
+        for (int i = 0; i < lines.size(); ++i)
+        {
+            const auto line = lines[i].upToFirstOccurrenceOf("#", false, false).trim();
+            if (line.isEmpty())
+                continue;
+
+            RenderJob job;
+            juce::String error;
+            if (!BatchRenderer::parseJob(line, file.getParentDirectory(), job, error))
+            {
+                std::cerr << file.getFileName() << ":" << (i + 1) << ": " << error << "\n";
+                return false;
+            }
+
+            jobs.push_back(job);
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    auto threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    auto blockSize = 512;
+    auto chunkSize = 16384;
+    std::vector<RenderJob> jobs;
+    const auto workingDirectory = juce::File::getCurrentWorkingDirectory();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg(argv[i]);
+        const auto hasValue = i + 1 < argc;
+
+        if ((arg == "--threads" || arg == "-j") && hasValue)
+            threads = std::max(1, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--block" && hasValue)
+            blockSize = std::max(1, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--chunk" && hasValue)
+            chunkSize = std::max(1, juce::String(argv[++i]).getIntValue());
+        else if (arg == "--job" && hasValue)
+        {
+            RenderJob job;
+            juce::String error;
+            if (!BatchRenderer::parseJob(argv[++i], workingDirectory, job, error))
+            {
+                std::cerr << "--job: " << error << "\n";
+                return 1;
+            }
+            jobs.push_back(job);
+        }
+        else if (arg == "--help" || arg == "-h" || arg.startsWith("-"))
+        {
+            printUsage();
+            return arg.startsWith("--help") || arg == "-h" ? 0 : 1;
+        }
+        else if (!readJobFile(workingDirectory.getChildFile(arg), jobs))
+        {
+            return 1;
+        }
+    }
+
+    if (jobs.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<RenderResult> results(jobs.size());
+    std::mutex printLock;
+    size_t completed = 0;
+    const auto batchStart = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        WorkStealingPool pool(std::min(threads, static_cast<int>(jobs.size())));
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            pool.submit([&, i]
+                        {
+                            results[i] = BatchRenderer::render(jobs[i], blockSize, chunkSize);
+
+                            const std::lock_guard<std::mutex> guard(printLock);
+                            const auto& result = results[i];
+                            std::cout << "[" << ++completed << "/" << jobs.size() << "] "
+                                      << jobs[i].output.getFileName();
+                            if (result.ok)
+                                std::cout << "  " << juce::String(result.audioSeconds, 1) << " s in "
+                                          << juce::String(result.wallSeconds, 2) << " s  ("
+                                          << juce::String(result.getRealtimeFactor(), 1) << "x realtime)"
+                                          << "  NaN " << result.nanCount << "  Inf " << result.infCount
+                                          << "  Den " << result.denormalCount << "  Recovered " << result.recoveryCount;
+                            else
+                                std::cout << "  FAILED: " << result.error;
+                            std::cout << std::endl;
+                        });
+        }
+
+        pool.wait();
+    }
+
+    const auto batchSeconds = (juce::Time::getMillisecondCounterHiRes() - batchStart) / 1000.0;
+    auto audioSeconds = 0.0;
+    auto failures = 0;
+    for (const auto& result : results)
+    {
+        audioSeconds += result.audioSeconds;
+        failures += result.ok ? 0 : 1;
+    }
+
+    std::cout << jobs.size() << " jobs, " << juce::String(audioSeconds, 1) << " s of audio in "
+              << juce::String(batchSeconds, 2) << " s on " << std::min(threads, static_cast<int>(jobs.size()))
+              << " threads: " << juce::String(batchSeconds > 0.0 ? audioSeconds / batchSeconds : 0.0, 1)
+              << "x realtime aggregate";
+    if (failures > 0)
+        std::cout << ", " << failures << " failed";
+    std::cout << std::endl;
+
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int numThreads)
+{
+    const auto count = static_cast<size_t>(std::max(1, numThreads));
+    for (size_t i = 0; i < count; ++i)
+        queues.push_back(std::make_unique<Queue>());
+
+    for (size_t i = 0; i < count; ++i)
+        threads.emplace_back([this, i] { run(i); });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    wait();
+
+    {
+        const std::lock_guard<std::mutex> guard(signalLock);
+        stopping = true;
+    }
+
+    workAvailable.notify_all();
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    const auto index = static_cast<size_t>(nextQueue.fetch_add(1)) % queues.size();
+    pending.fetch_add(1);
+
+    {
+        auto& queue = *queues[index];
+        const std::lock_guard<std::mutex> guard(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        const std::lock_guard<std::mutex> guard(signalLock);
+        queued.fetch_add(1);
+    }
+
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+    std::unique_lock<std::mutex> guard(signalLock);
+    allDone.wait(guard, [this] { return pending.load() == 0; });
+}
+
+bool WorkStealingPool::tryPop(size_t worker, Task& task)
+{
+    auto& queue = *queues[worker];
+    const std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.tasks.empty())
+        return false;
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::trySteal(size_t worker, Task& task)
+{
+    for (size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        auto& queue = *queues[(worker + offset) % queues.size()];
+        const std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty())
+            continue;
+
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    return false;
+}
+
+void WorkStealingPool::run(size_t worker)
+{
+    for (;;)
+    {
+        Task task;
+        if (tryPop(worker, task) || trySteal(worker, task))
+        {
+            queued.fetch_sub(1);
+            task();
+
+            if (pending.fetch_sub(1) == 1)
+            {
+                const std::lock_guard<std::mutex> guard(signalLock);
+                allDone.notify_all();
+            }
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(signalLock);
+        workAvailable.wait(guard, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0)
+            return;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool for coarse jobs. Each worker owns a deque: it takes its own work from the back and,
+// when empty, steals from the front of the others, so uneven job lengths still keep every thread
+// busy. Tasks must not throw.
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(int numThreads);
+    ~WorkStealingPool();
+
+    int getNumThreads() const { return static_cast<int>(threads.size()); }
+
+    void submit(Task task);
+    // Blocks until every submitted task has finished.
+    void wait();
+
+private:
+    struct Queue
+    {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    bool tryPop(size_t worker, Task& task);
+    bool trySteal(size_t worker, Task& task);
+    void run(size_t worker);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex signalLock;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    std::atomic<int> queued { 0 };
+    std::atomic<int> pending { 0 };
+    std::atomic<unsigned> nextQueue { 0 };
+    bool stopping = false;
+};
@@ -0,0 +1,161 @@
+#include "BufferProvisioner.h"
+
+#include <algorithm>
+#include <cmath>
+
+BufferProvisioner::BufferProvisioner()
+{
+    worker = std::thread([this] { run(); });
+}
+
+BufferProvisioner::~BufferProvisioner()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+
+    wake.notify_one();
+    worker.join();
+}
+
+void BufferProvisioner::request(const Layout& newLayout, const Source& newSource)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return !hasJob; });
+
+        // The audio thread may be mid-swap of the previous result; it never blocks, so just let it finish.
+        for (;;)
+        {
+            auto expected = state.load();
+            if (expected == State::Taking)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (state.compare_exchange_weak(expected, State::Working))
+                break;
+        }
+
+        layout = newLayout;
+        source = newSource;
+        hasJob = true;
+    }
+
+    wake.notify_one();
+}
+
+void BufferProvisioner::waitUntilReady()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return !hasJob; });
+}
+
+void BufferProvisioner::releaseRetired()
+{
+    if (state.load() == State::Idle)
+        MemoryBuffer().swap(slot);
+}
+
+bool BufferProvisioner::take(MemoryBuffer& target, Placement& placement)
+{
+    auto expected = State::Ready;
+    if (!state.compare_exchange_strong(expected, State::Taking))
+        return false;
+
+    target.swap(slot);
+    placement = result;
+    state.store(State::Idle);
+    return true;
+}
+
+void BufferProvisioner::run()
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return hasJob || quit; });
+            if (quit)
+                return;
+        }
+
+        build();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            hasJob = false;
+            state.store(State::Ready);
+        }
+
+        done.notify_all();
+    }
+}
+
+void BufferProvisioner::build()
+{
+    slot.prepare(layout.channels, layout.size, layout.format);
+    result = {};
+    result.sampleRate = layout.sampleRate;
+
+    const auto* buffer = source.buffer;
+    if (buffer == nullptr || buffer->getSize() <= 0)
+        return;
+
+    const auto ratio = source.sampleRate > 0.0 && layout.sampleRate > 0.0 ? layout.sampleRate / source.sampleRate
+                                                                          : 1.0;
+    const auto resampling = ratio != 1.0;
+
+    result.sourceSize = buffer->getSize();
+    result.kept = std::min(result.sourceSize, static_cast<int>(std::lround(slot.getSize() / ratio)));
+    result.written = resampling ? std::min(slot.getSize(), static_cast<int>(std::lround(result.kept * ratio)))
+                                : result.kept;
+    result.offset = buffer->getWriteIndex() - result.kept;
+    if (result.offset < 0)
+        result.offset += result.sourceSize;
+
+    if (resampling)
+    {
+        converter.prepare(ratio);
+        convert(result.offset, result.kept, 0, result.written);
+    }
+    else
+    {
+        slot.copyFrom(*buffer, result.offset, result.kept);
+    }
+
+    slot.setWriteIndex(result.written);
+
+    auto loopOffset = source.loopStart - result.offset;
+    if (loopOffset < 0)
+        loopOffset += result.sourceSize;
+
+    if (source.loopLength <= 0 || loopOffset + source.loopLength > result.kept || result.written <= 0)
+        return;
+
+    // Same length in seconds; the start is pulled in if rounding would run it past the new content.
+    result.loopLength = std::max(1, static_cast<int>(std::lround(source.loopLength * ratio)));
+    result.loopLength = std::min(result.loopLength, result.written);
+    result.loopStart = std::min(static_cast<int>(std::lround(loopOffset * ratio)), result.written - result.loopLength);
+
+    if (resampling)
+        convert(source.loopStart, source.loopLength, result.loopStart, result.loopLength);
+}
+
+void BufferProvisioner::convert(int start, int length, int destStart, int destLength)
+{
+    const auto* buffer = source.buffer;
+    cycle.resize(static_cast<size_t>(length));
+    converted.resize(static_cast<size_t>(destLength));
+
+    for (int channel = 0; channel < std::min(buffer->getNumChannels(), slot.getNumChannels()); ++channel)
+    {
+        for (int i = 0; i < length; ++i)
+            cycle[static_cast<size_t>(i)] = buffer->readSample(channel, start + i);
+
+        converter.process(cycle.data(), length, converted.data(), destLength);
+        slot.writeBlock(channel, destStart, converted.data(), destLength);
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "MemoryBuffer.h"
+#include "RateConverter.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Builds replacement delay memory on a worker thread. A request names the new layout and the
+// buffer whose most recent content should carry over; the worker allocates, clears and copies
+// (resampling when the rates differ), and the audio thread picks the result up with take(),
+// which only swaps storage. The source must not be written from request() until take() succeeds.
+class BufferProvisioner
+{
+public:
+    struct Layout
+    {
+        int channels = 0;
+        int size = 0;
+        SampleFormat format = SampleFormat::Float32;
+        double sampleRate = 0.0;
+    };
+
+    // The buffer to carry over and the loop inside it. The loop is converted as a cycle of its
+    // own so its seam stays clean.
+    struct Source
+    {
+        const MemoryBuffer* buffer = nullptr;
+        double sampleRate = 0.0;
+        int loopStart = 0;
+        int loopLength = 0;
+    };
+
+    // The newest `kept` source samples, starting at source index `offset`, became the first
+    // `written` samples of the new buffer. The loop has length 0 when it did not fit.
+    struct Placement
+    {
+        double sampleRate = 0.0;
+        int sourceSize = 0;
+        int offset = 0;
+        int kept = 0;
+        int written = 0;
+        int loopStart = 0;
+        int loopLength = 0;
+    };
+
+    BufferProvisioner();
+    ~BufferProvisioner();
+
+    // Message thread. Supersedes a result that has not been taken yet.
+    void request(const Layout& layout, const Source& source);
+    // Message thread. Blocks until the current request is ready (for offline rendering).
+    void waitUntilReady();
+    // Message thread. Frees the storage swapped out by the last take().
+    void releaseRetired();
+
+    // True from request() until take() has swapped the result in.
+    bool isPending() const { return state.load() != State::Idle; }
+
+    // Audio thread. Swaps a ready buffer into `target` without allocating; the previous storage
+    // is retired for releaseRetired().
+    bool take(MemoryBuffer& target, Placement& placement);
+
+private:
+    enum class State
+    {
+        Idle,
+        Working,
+        Ready,
+        Taking
+    };
+
+    void run();
+    void build();
+    void convert(int start, int length, int destStart, int destLength);
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    bool hasJob = false;
+    bool quit = false;
+
+    Layout layout;
+    Source source;
+    MemoryBuffer slot;
+    RateConverter converter;
+    std::vector<float> cycle;
+    std::vector<float> converted;
+    Placement result;
+    std::atomic<State> state { State::Idle };
+};
@@ -0,0 +1,256 @@
+#include "DelayKernel.h"
+
+#include "FeedbackModel.h"
+#include "MemoryBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+    // Same result as MemoryBuffer's modulo wrap; the common cases skip the division.
+    int wrapIndex(int index, int size)
+    {
+        if (index < 0)
+            index += size;
+        else if (index >= size)
+            index -= size;
+
+        if (index < 0 || index >= size)
+        {
+            index %= size;
+            if (index < 0)
+                index += size;
+        }
+
+        return index;
+    }
+
+    float loadSample(const float* data, int index, const SampleCodec&) { return data[index]; }
+    float loadSample(const std::int16_t* data, int index, const SampleCodec& codec) { return codec.unpack(data[index]); }
+    void storeSample(float* data, int index, float value, const SampleCodec&) { data[index] = value; }
+    void storeSample(std::int16_t* data, int index, float value, const SampleCodec& codec) { data[index] = codec.pack(value); }
+
+    template <bool Authentic, bool Noise, bool Fading, bool Tapping, bool Packed>
+    void processFixed(const DelayKernel::Block& block, MemoryBuffer& memory, FeedbackModel& degrade, float feedback,
+                      DelayKernel::Spread& spread)
+    {
+        const auto size = memory.getSize();
+        const auto numChannels = std::min({ block.numChannels, memory.getNumChannels(), FeedbackModel::maxChannels });
+        if (size <= 0 || numChannels <= 0)
+            return;
+
+        // Channels are stored back to back, so one base pointer covers them all.
+        using Sample = std::conditional_t<Packed, std::int16_t, float>;
+        Sample* base = nullptr;
+        if constexpr (Packed)
+            base = memory.getPackedWritePointer(0);
+        else
+            base = memory.getWritePointer(0);
+
+        const auto codec = memory.getCodec();
+        auto writeIndex = memory.getWriteIndex();
+
+        for (int i = 0; i < block.numSamples; ++i)
+        {
+            const auto readIndex = static_cast<float>(writeIndex) - block.delays[i];
+            int indexA = 0;
+            int indexB = 0;
+            auto frac = 0.0f;
+
+            if constexpr (Authentic)
+            {
+                indexA = wrapIndex(static_cast<int>(readIndex), size);
+            }
+            else
+            {
+                const auto baseIndex = static_cast<int>(std::floor(readIndex));
+                frac = readIndex - static_cast<float>(baseIndex);
+                indexA = wrapIndex(baseIndex, size);
+                indexB = indexA + 1 == size ? 0 : indexA + 1;
+            }
+
+            // Near taps read the mono sum at their distance; everything up to the previous frame
+            // has been written by now.
+            FeedbackModel::Frame nearOutput {};
+            FeedbackModel::Frame nearSend {};
+            if constexpr (Tapping)
+            {
+                const auto ramp = static_cast<float>(i + 1);
+                for (int t = 0; t < block.numNearTaps; ++t)
+                {
+                    const auto& tap = block.nearTaps[t];
+                    const auto tapA = wrapIndex(writeIndex - tap.wholeDelay, size);
+                    const auto tapB = tapA + 1 == size ? 0 : tapA + 1;
+                    auto sum = 0.0f;
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        const auto* data = base + static_cast<size_t>(channel) * static_cast<size_t>(size);
+                        const auto sampleA = loadSample(data, tapA, codec);
+                        sum += sampleA + (loadSample(data, tapB, codec) - sampleA) * tap.fraction;
+                    }
+
+                    const auto gain = tap.gain + tap.gainStep * ramp;
+                    const auto send = tap.send + tap.sendStep * ramp;
+                    for (int channel = 0; channel < numChannels; ++channel)
+                    {
+                        const auto value = sum * tap.scale[static_cast<size_t>(std::min(channel, 1))];
+                        nearOutput[static_cast<size_t>(channel)] += value * gain;
+                        nearSend[static_cast<size_t>(channel)] += value * send;
+                    }
+                }
+            }
+
+            // The degrade chain takes the whole frame at once, one channel per filter lane.
+            FeedbackModel::Frame frame {};
+            FeedbackModel::Frame random {};
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const auto* data = base + static_cast<size_t>(channel) * static_cast<size_t>(size);
+                float readSample;
+                if constexpr (Authentic)
+                {
+                    readSample = loadSample(data, indexA, codec);
+                }
+                else
+                {
+                    const auto sampleA = loadSample(data, indexA, codec);
+                    readSample = sampleA + (loadSample(data, indexB, codec) - sampleA) * frac;
+                }
+
+                if constexpr (Fading)
+                {
+                    const auto fadeGain = block.fadeGains[i];
+                    readSample = readSample * fadeGain + block.fadeRead[channel][i] * (1.0f - fadeGain);
+                }
+
+                auto wet = readSample;
+                if constexpr (Tapping)
+                    wet += block.tapOutputs[channel][i] + nearOutput[static_cast<size_t>(channel)];
+                block.wet[channel][i] = wet;
+
+                frame[static_cast<size_t>(channel)] = readSample;
+                if constexpr (Noise)
+                    random[static_cast<size_t>(channel)] = block.noise[channel][i];
+            }
+
+            degrade.processFrameFixed<Noise>(frame, random, numChannels, feedback);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* data = base + static_cast<size_t>(channel) * static_cast<size_t>(size);
+                auto writeValue = block.input[channel][i] + frame[static_cast<size_t>(channel)];
+                if constexpr (Tapping)
+                    writeValue += block.tapSends[channel][i] + nearSend[static_cast<size_t>(channel)];
+
+                storeSample(data, writeIndex, writeValue, codec);
+
+                const auto slot = static_cast<size_t>(std::min(channel, 1));
+                spread.min[slot] = std::min(spread.min[slot], writeValue);
+                spread.max[slot] = std::max(spread.max[slot], writeValue);
+            }
+
+            writeIndex = writeIndex + 1 == size ? 0 : writeIndex + 1;
+        }
+
+        memory.setWriteIndex(writeIndex);
+    }
+
+    template <int Index>
+    constexpr DelayKernel::Function makeVariant()
+    {
+        return &processFixed<(Index & 1) != 0, (Index & 2) != 0, (Index & 4) != 0, (Index & 8) != 0,
+                             (Index & 16) != 0>;
+    }
+
+    template <int... Indices>
+    constexpr std::array<DelayKernel::Function, sizeof...(Indices)> makeTable(std::integer_sequence<int, Indices...>)
+    {
+        return { makeVariant<Indices>()... };
+    }
+
+    constexpr auto kVariants = makeTable(std::make_integer_sequence<int, DelayKernel::numVariants>());
+}
+
+int DelayKernel::getIndex(const Flags& flags)
+{
+    return (flags.authentic ? 1 : 0) | (flags.noise ? 2 : 0) | (flags.fading ? 4 : 0) | (flags.tapping ? 8 : 0)
+           | (flags.packed ? 16 : 0);
+}
+
+DelayKernel::Function DelayKernel::select(const Flags& flags)
+{
+    return kVariants[static_cast<size_t>(getIndex(flags))];
+}
+
+void DelayKernel::processGeneric(const Block& block, const Flags& flags, MemoryBuffer& memory, FeedbackModel& degrade,
+                                 float feedback, Spread& spread)
+{
+    const auto numChannels = std::min({ block.numChannels, memory.getNumChannels(), FeedbackModel::maxChannels });
+
+    for (int i = 0; i < block.numSamples; ++i)
+    {
+        const auto writeIndex = memory.getWriteIndex();
+        const auto readIndex = static_cast<float>(writeIndex) - block.delays[i];
+        FeedbackModel::Frame frame {};
+        FeedbackModel::Frame random {};
+        FeedbackModel::Frame nearOutput {};
+        FeedbackModel::Frame nearSend {};
+
+        for (int t = 0; flags.tapping && t < block.numNearTaps; ++t)
+        {
+            const auto& tap = block.nearTaps[t];
+            const auto tapIndex = writeIndex - tap.wholeDelay;
+            auto sum = 0.0f;
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const auto sampleA = memory.readSample(channel, tapIndex);
+                sum += sampleA + (memory.readSample(channel, tapIndex + 1) - sampleA) * tap.fraction;
+            }
+
+            const auto ramp = static_cast<float>(i + 1);
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const auto value = sum * tap.scale[static_cast<size_t>(std::min(channel, 1))];
+                nearOutput[static_cast<size_t>(channel)] += value * (tap.gain + tap.gainStep * ramp);
+                nearSend[static_cast<size_t>(channel)] += value * (tap.send + tap.sendStep * ramp);
+            }
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto readSample = flags.authentic ? memory.readSample(channel, static_cast<int>(readIndex))
+                                              : memory.readSampleLinear(channel, readIndex);
+            if (flags.fading)
+            {
+                const auto fadeGain = block.fadeGains[i];
+                readSample = readSample * fadeGain + block.fadeRead[channel][i] * (1.0f - fadeGain);
+            }
+
+            block.wet[channel][i] = readSample
+                                    + (flags.tapping ? block.tapOutputs[channel][i] + nearOutput[static_cast<size_t>(channel)]
+                                                     : 0.0f);
+            frame[static_cast<size_t>(channel)] = readSample;
+            random[static_cast<size_t>(channel)] = flags.noise ? block.noise[channel][i] : 0.0f;
+        }
+
+        degrade.processFrame(frame, random, numChannels, feedback);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto writeValue = block.input[channel][i] + frame[static_cast<size_t>(channel)];
+            if (flags.tapping)
+                writeValue += block.tapSends[channel][i] + nearSend[static_cast<size_t>(channel)];
+
+            memory.writeSample(channel, writeIndex, writeValue);
+
+            const auto slot = static_cast<size_t>(std::min(channel, 1));
+            spread.min[slot] = std::min(spread.min[slot], writeValue);
+            spread.max[slot] = std::max(spread.max[slot], writeValue);
+        }
+
+        memory.advanceWrite();
+    }
+}
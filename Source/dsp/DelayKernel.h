@@ -0,0 +1,69 @@
+#pragma once
+
+#include "MultiTap.h"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+
+class FeedbackModel;
+class MemoryBuffer;
+
+// The delay-line loop of the engine: read behind the write head, degrade, write back. Everything
+// that is fixed for a chunk (read interpolation, grit, head fade, taps, storage format) is compiled
+// into one of numVariants specialisations, and select() picks one per chunk from a table, so the
+// per-sample loop carries no mode branches. processGeneric() is the runtime-branching loop the
+// specialisations are tested and benchmarked against.
+class DelayKernel
+{
+public:
+    struct Flags
+    {
+        bool authentic = false; // nearest-sample reads instead of linear
+        bool noise = false;     // grit stage of the degrade chain is on
+        bool fading = false;    // blend in the previous read head
+        bool tapping = false;   // add tap outputs and feedback sends
+        bool packed = false;    // the buffer holds integer words (must match the buffer's format)
+    };
+
+    // Per-channel spans of numSamples. delays holds the read distance (modulation included) per
+    // frame; wet receives the read signal plus taps. Near taps, closer than the block, are read
+    // here per frame from what the block has already written. Unused inputs may be null.
+    struct Block
+    {
+        const float* const* input = nullptr;
+        float* const* wet = nullptr;
+        const float* const* noise = nullptr;
+        const float* const* fadeRead = nullptr;
+        const float* fadeGains = nullptr;
+        const float* const* tapOutputs = nullptr;
+        const float* const* tapSends = nullptr;
+        const float* delays = nullptr;
+        int numChannels = 0;
+        int numSamples = 0;
+        const MultiTap::NearTap* nearTaps = nullptr;
+        int numNearTaps = 0;
+    };
+
+    // Range of the values written, per channel; channels past the second share the second slot.
+    struct Spread
+    {
+        std::array<float, 2> min { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        std::array<float, 2> max { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+        float getRange(int slot) const { return max[static_cast<size_t>(slot)] - min[static_cast<size_t>(slot)]; }
+    };
+
+    // The degrade chain must already have its parameters set for the chunk. The write head
+    // advances by numSamples.
+    using Function = void (*)(const Block& block, MemoryBuffer& memory, FeedbackModel& degrade, float feedback,
+                              Spread& spread);
+
+    static constexpr int numVariants = 32;
+
+    static int getIndex(const Flags& flags);
+    static Function select(const Flags& flags);
+
+    static void processGeneric(const Block& block, const Flags& flags, MemoryBuffer& memory, FeedbackModel& degrade,
+                               float feedback, Spread& spread);
+};
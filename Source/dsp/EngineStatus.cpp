@@ -0,0 +1,61 @@
+#include "EngineStatus.h"
+
+#include <algorithm>
+#include <cstring>
+
+float EngineStatus::getLoopProgress() const
+{
+    if (loopLength <= 0)
+        return 0.0f;
+
+    return std::clamp(static_cast<float>(playhead / loopLength), 0.0f, 1.0f);
+}
+
+float EngineStatus::getRecordProgress() const
+{
+    if (capacitySamples <= 0)
+        return 0.0f;
+
+    return std::clamp(static_cast<float>(recordedSamples) / static_cast<float>(capacitySamples), 0.0f, 1.0f);
+}
+
+void EngineStatusChannel::publish(const EngineStatus& status) noexcept
+{
+    std::array<std::uint64_t, numWords> raw {};
+    std::memcpy(raw.data(), static_cast<const void*>(&status), sizeof(EngineStatus));
+
+    // Odd while writing; the release fence keeps the word stores after the bump.
+    const auto start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (std::size_t i = 0; i < numWords; ++i)
+        words[i].store(raw[i], std::memory_order_relaxed);
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+bool EngineStatusChannel::read(EngineStatus& status) const noexcept
+{
+    std::array<std::uint64_t, numWords> raw {};
+
+    for (int attempt = 0; attempt < maxReadAttempts; ++attempt)
+    {
+        const auto before = sequence.load(std::memory_order_acquire);
+        if ((before & 1u) != 0)
+            continue;
+
+        for (std::size_t i = 0; i < numWords; ++i)
+            raw[i] = words[i].load(std::memory_order_relaxed);
+
+        // The acquire fence keeps the word loads ahead of the second sequence check.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before)
+            continue;
+
+        std::memcpy(static_cast<void*>(&status), raw.data(), sizeof(EngineStatus));
+        return true;
+    }
+
+    return false;
+}
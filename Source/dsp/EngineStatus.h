@@ -0,0 +1,53 @@
+#pragma once
+
+#include "StateMachine.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// What the engine is doing, as of the end of the last processed block.
+struct EngineStatus
+{
+    LoopState state = LoopState::Idle;
+    bool clip = false;
+    bool sleeping = false;
+    // Playback direction and speed switches as the engine ran them, ahead of the host parameters.
+    bool reverse = false;
+    bool halfSpeed = false;
+    float meterL = 0.0f;
+    float meterR = 0.0f;
+    double sampleRate = 0.0;
+    // Samples into the loop; loopLength is 0 when nothing has been recorded.
+    double playhead = 0.0;
+    int loopLength = 0;
+    int recordedSamples = 0;
+    int capacitySamples = 0;
+    std::uint64_t processedSamples = 0;
+
+    float getLoopProgress() const;
+    float getRecordProgress() const;
+};
+
+static_assert(std::is_trivially_copyable<EngineStatus>::value, "EngineStatus is copied as raw words");
+
+// Single-writer seqlock: the audio thread publishes without waiting, readers retry while a
+// publish is in flight and always see one block's status, never a mix of two.
+class EngineStatusChannel
+{
+public:
+    // Audio thread only.
+    void publish(const EngineStatus& status) noexcept;
+
+    // Any other thread. Returns false, leaving `status` untouched, if the writer kept
+    // overtaking the read.
+    bool read(EngineStatus& status) const noexcept;
+
+private:
+    static constexpr int maxReadAttempts = 16;
+    static constexpr std::size_t numWords = (sizeof(EngineStatus) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<std::uint32_t> sequence { 0 };
+    std::array<std::atomic<std::uint64_t>, numWords> words {};
+};
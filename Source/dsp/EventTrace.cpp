@@ -0,0 +1,118 @@
+#include "EventTrace.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr std::uint64_t kMask = static_cast<std::uint64_t>(EventTrace::capacity - 1);
+}
+
+const char* TraceEvent::getTypeName(Type type)
+{
+    switch (type)
+    {
+        case Type::StateChange: return "state";
+        case Type::ClearEdge: return "clear";
+        case Type::LoopLength: return "loopLength";
+        case Type::LoopStart: return "loopStart";
+        case Type::Parameter: return "param";
+        case Type::Footswitch: return "footswitch";
+    }
+
+    return "unknown";
+}
+
+void EventTrace::push(const TraceEvent& event) noexcept
+{
+    const auto position = writePosition.load(std::memory_order_relaxed);
+    auto& slot = slots[static_cast<size_t>(position & kMask)];
+
+    std::array<std::uint64_t, numWords> raw {};
+    std::memcpy(raw.data(), static_cast<const void*>(&event), sizeof(TraceEvent));
+
+    // Odd sequence marks the slot as being written.
+    slot.sequence.store(position * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < numWords; ++i)
+        slot.words[i].store(raw[i], std::memory_order_relaxed);
+    slot.sequence.store(position * 2 + 2, std::memory_order_release);
+    writePosition.store(position + 1, std::memory_order_release);
+}
+
+void EventTrace::push(std::uint64_t sampleTime, TraceEvent::Type type, int id, float previous,
+                      float current) noexcept
+{
+    TraceEvent event;
+    event.sampleTime = sampleTime;
+    event.type = type;
+    event.id = id;
+    event.previous = previous;
+    event.current = current;
+    push(event);
+}
+
+bool EventTrace::readSlot(std::uint64_t position, TraceEvent& dest) const noexcept
+{
+    const auto& slot = slots[static_cast<size_t>(position & kMask)];
+    const auto expected = position * 2 + 2;
+
+    if (slot.sequence.load(std::memory_order_acquire) != expected)
+        return false;
+
+    std::array<std::uint64_t, numWords> raw {};
+    for (std::size_t i = 0; i < numWords; ++i)
+        raw[i] = slot.words[i].load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected)
+        return false;
+
+    std::memcpy(static_cast<void*>(&dest), raw.data(), sizeof(TraceEvent));
+    return true;
+}
+
+int EventTrace::read(TraceEvent* dest, int maxEvents) noexcept
+{
+    if (dest == nullptr || maxEvents <= 0)
+        return 0;
+
+    const auto end = writePosition.load(std::memory_order_acquire);
+    const auto oldest = end > static_cast<std::uint64_t>(capacity) ? end - capacity : 0;
+    if (readPosition < oldest)
+    {
+        dropped += oldest - readPosition;
+        readPosition = oldest;
+    }
+
+    int count = 0;
+    while (readPosition < end && count < maxEvents)
+    {
+        if (readSlot(readPosition, dest[count]))
+            ++count;
+        else
+            ++dropped;
+
+        ++readPosition;
+    }
+
+    return count;
+}
+
+int EventTrace::copyRecent(TraceEvent* dest, int maxEvents) const noexcept
+{
+    if (dest == nullptr || maxEvents <= 0)
+        return 0;
+
+    const auto end = writePosition.load(std::memory_order_acquire);
+    const auto available = std::min<std::uint64_t>(end, static_cast<std::uint64_t>(std::min(maxEvents, capacity)));
+
+    int count = 0;
+    for (auto position = end - available; position < end; ++position)
+    {
+        if (readSlot(position, dest[count]))
+            ++count;
+    }
+
+    return count;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+struct TraceEvent
+{
+    enum class Type : std::uint8_t
+    {
+        StateChange,
+        ClearEdge,
+        LoopLength,
+        LoopStart,
+        Parameter,
+        Footswitch
+    };
+
+    std::uint64_t sampleTime = 0;
+    Type type = Type::StateChange;
+    int id = 0;
+    float previous = 0.0f;
+    float current = 0.0f;
+
+    static const char* getTypeName(Type type);
+};
+
+static_assert(std::is_trivially_copyable<TraceEvent>::value, "TraceEvent is copied as raw words");
+
+// Single-writer flight recorder: the audio thread pushes, one reader thread drains.
+// When the reader falls behind, the oldest events are overwritten and counted as dropped.
+class EventTrace
+{
+public:
+    static constexpr int capacity = 1024;
+
+    void push(const TraceEvent& event) noexcept;
+    void push(std::uint64_t sampleTime, TraceEvent::Type type, int id, float previous, float current) noexcept;
+
+    int read(TraceEvent* dest, int maxEvents) noexcept;
+    int copyRecent(TraceEvent* dest, int maxEvents) const noexcept;
+
+    std::uint64_t getWriteCount() const { return writePosition.load(std::memory_order_acquire); }
+    std::uint64_t getDroppedCount() const { return dropped; }
+
+private:
+    static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+    static constexpr std::size_t numWords = (sizeof(TraceEvent) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    // The event is stored as relaxed atomic words, so a reader racing the writer only ever sees
+    // torn values, which the sequence check then discards.
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence { 0 };
+        std::array<std::atomic<std::uint64_t>, numWords> words {};
+    };
+
+    bool readSlot(std::uint64_t position, TraceEvent& dest) const noexcept;
+
+    std::array<Slot, capacity> slots;
+    std::atomic<std::uint64_t> writePosition { 0 };
+    std::uint64_t readPosition = 0;
+    std::uint64_t dropped = 0;
+};
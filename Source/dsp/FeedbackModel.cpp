@@ -8,66 +8,110 @@
 void FeedbackModel::reset(double newSampleRate)
 {
     sampleRate = (newSampleRate > 0.0) ? newSampleRate : 44100.0;
-    lpState = 0.0f;
-    lpAlpha = 1.0f;
+    filter.prepare(sampleRate);
     quantizeLevels = 0;
+    deadZone = 0.0f;
+    noise = 0.0f;
 }
 
-float FeedbackModel::process(float input,
+float FeedbackModel::process(int channel,
+                             float input,
                              float filterAmount,
                              float noiseAmount,
                              float feedbackGain,
                              float random01)
 {
-    updateFilter(filterAmount, noiseAmount);
+    setParameters(filterAmount, noiseAmount);
+    return processSample(channel, input, feedbackGain, random01);
+}
+
+float FeedbackModel::processSample(int channel, float input, float feedbackGain, float random01)
+{
+    const auto filtered = filter.processSample(std::clamp(channel, 0, maxChannels - 1), input);
+    return hasNoise() ? shape<true>(filtered, feedbackGain, random01)
+                      : shape<false>(filtered, feedbackGain, random01);
+}
 
-    auto value = lowpass(input);
+void FeedbackModel::processFrame(Frame& frame, const Frame& random01, int numChannels, float feedbackGain)
+{
+    if (hasNoise())
+        processFrameFixed<true>(frame, random01, numChannels, feedbackGain);
+    else
+        processFrameFixed<false>(frame, random01, numChannels, feedbackGain);
+}
 
-    // Soft clip
-    value = std::tanh(value);
+void FeedbackModel::processBlock(float* const* channels,
+                                 const float* const* random01,
+                                 int numChannels,
+                                 int numSamples,
+                                 float feedbackGain)
+{
+    numChannels = std::min(numChannels, maxChannels);
 
-    // Quantize (bit crush)
-    if (quantizeLevels > 1)
+    for (int i = 0; i < numSamples; ++i)
     {
-        const auto normalized = (value + 1.0f) * 0.5f;
-        const auto stepped = std::round(normalized * static_cast<float>(quantizeLevels - 1)) /
-                             static_cast<float>(quantizeLevels - 1);
-        value = stepped * 2.0f - 1.0f;
+        Frame frame {};
+        for (int channel = 0; channel < numChannels; ++channel)
+            frame[static_cast<size_t>(channel)] = channels[channel][i];
+
+        filter.processFrame(frame);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            channels[channel][i] = frame[static_cast<size_t>(channel)];
     }
 
-    // Noise injection
-    if (noiseAmount > 0.0f)
+    for (int channel = 0; channel < numChannels; ++channel)
     {
-        const auto noise = random01 * 2.0f - 1.0f;
-        value += noise * noiseAmount * 0.02f;
+        auto* data = channels[channel];
+
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = std::tanh(data[i]);
+
+        if (quantizeLevels > 1)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] = quantize(data[i]);
+        }
+
+        if (noise > 0.0f)
+        {
+            const auto* random = random01[channel];
+            for (int i = 0; i < numSamples; ++i)
+            {
+                if (data[i] != 0.0f)
+                    data[i] += (random[i] * 2.0f - 1.0f) * noise * 0.02f;
+            }
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto value = data[i] * feedbackGain;
+            data[i] = std::isfinite(value) ? value : 0.0f;
+        }
     }
+}
 
-    value *= feedbackGain;
-
-    if (!std::isfinite(value))
-        return 0.0f;
-
-    return value;
+void FeedbackModel::setParameters(float filterAmount, float noiseAmount)
+{
+    setParameters({ filterAmount }, noiseAmount, 0);
 }
 
-void FeedbackModel::updateFilter(float filterAmount, float noiseAmount)
+void FeedbackModel::setParameters(const Tone& tone, float noiseAmount, int numSamples)
 {
-    filterAmount = std::clamp(filterAmount, 0.0f, 1.0f);
+    noise = noiseAmount;
+
+    const auto filterAmount = std::clamp(tone.filterAmount, 0.0f, 1.0f);
 
     const auto minHz = 800.0f;
     const auto maxHz = 12000.0f;
     const auto cutoff = minHz + (maxHz - minHz) * filterAmount;
-    constexpr float kPi = 3.14159265358979323846f;
-    const auto x = std::exp(-2.0f * kPi * cutoff / static_cast<float>(sampleRate));
-    lpAlpha = 1.0f - x;
+    filter.setTarget(cutoff, tone.resonance, tone.mode);
+    filter.updateCoefficients(numSamples);
 
     const auto maxLevels = 256;
     const auto levelFloat = 2.0f + (maxLevels - 2.0f) * (1.0f - noiseAmount);
     quantizeLevels = static_cast<int>(levelFloat);
-}
 
-float FeedbackModel::lowpass(float input)
-{
-    lpState += lpAlpha * (input - lpState);
-    return lpState;
+    // Half a step. Two levels are a sign bit, with no silence to fall into.
+    deadZone = quantizeLevels > 2 ? 1.0f / static_cast<float>(quantizeLevels - 1) : 0.0f;
 }
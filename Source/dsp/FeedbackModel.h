@@ -1,21 +1,103 @@
 #pragma once
 
+#include "StateVariableFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
 class FeedbackModel
 {
 public:
+    using Frame = StateVariableFilter::Frame;
+    static constexpr int maxChannels = StateVariableFilter::numLanes;
+
+    // The feedback tone: cutoff (800 Hz to 12 kHz), resonance and response of the filter.
+    struct Tone
+    {
+        float filterAmount = 0.0f;
+        float resonance = 0.0f;
+        StateVariableFilter::Mode mode = StateVariableFilter::Mode::Lowpass;
+    };
+
     void reset(double sampleRate);
-    float process(float input,
+    float process(int channel,
+                  float input,
                   float filterAmount,
                   float noiseAmount,
                   float feedbackGain,
                   float random01);
 
+    // Block form: set the tone/grit once, then run samples without re-deriving coefficients.
+    // With numSamples the cutoff and resonance glide towards the tone over the block; the
+    // two-argument form is a plain lowpass and jumps straight there.
+    void setParameters(float filterAmount, float noiseAmount);
+    void setParameters(const Tone& tone, float noiseAmount, int numSamples);
+    float processSample(int channel, float input, float feedbackGain, float random01);
+    bool hasNoise() const { return noise > 0.0f; }
+
+    // One frame of all channels at once: the filter runs every channel in its own lane, then the
+    // shaping stages run per channel. WithNoise must match hasNoise() for the current parameters;
+    // random01 is only read when it is set. Lanes from numChannels on are left as the filter
+    // made them.
+    template <bool WithNoise>
+    void processFrameFixed(Frame& frame, const Frame& random01, int numChannels, float feedbackGain)
+    {
+        filter.processFrame(frame);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const auto index = static_cast<size_t>(channel);
+            frame[index] = shape<WithNoise>(frame[index], feedbackGain, random01[index]);
+        }
+    }
+
+    void processFrame(Frame& frame, const Frame& random01, int numChannels, float feedbackGain);
+
+    // In-place block form of processSample over per-channel spans. Only the filter runs frame by
+    // frame, all channels in one pass; the shaping stages run as straight per-channel loops.
+    // Channels past maxChannels are left untouched.
+    void processBlock(float* const* channels,
+                      const float* const* random01,
+                      int numChannels,
+                      int numSamples,
+                      float feedbackGain);
+
 private:
-    void updateFilter(float filterAmount, float noiseAmount);
-    float lowpass(float input);
+    template <bool WithNoise>
+    float shape(float filtered, float feedbackGain, float random01) const
+    {
+        auto value = std::tanh(filtered);
+
+        if (quantizeLevels > 1)
+            value = quantize(value);
+
+        // Grit rides on the signal: a value the quantizer has flattened to silence gets none, so
+        // a decayed loop goes quiet instead of recirculating its own hiss.
+        if constexpr (WithNoise)
+        {
+            if (value != 0.0f)
+                value += (random01 * 2.0f - 1.0f) * noise * 0.02f;
+        }
+
+        value *= feedbackGain;
+        return std::isfinite(value) ? value : 0.0f;
+    }
+
+    // Anything within half a step of zero comes out as silence. Without that dead zone an odd
+    // number of steps has no zero level, and a decaying loop never dies out: it ends up toggling
+    // between the two levels either side of zero for good.
+    float quantize(float value) const
+    {
+        if (std::abs(value) < deadZone)
+            return 0.0f;
+
+        const auto steps = static_cast<float>(quantizeLevels - 1);
+        return std::round((value + 1.0f) * 0.5f * steps) / steps * 2.0f - 1.0f;
+    }
 
     double sampleRate = 44100.0;
-    float lpAlpha = 1.0f;
-    float lpState = 0.0f;
+    StateVariableFilter filter;
     int quantizeLevels = 0;
+    float deadZone = 0.0f;
+    float noise = 0.0f;
 };
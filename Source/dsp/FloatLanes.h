@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#if !defined(SIXTEEN_SECOND_SCALAR_LANES) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+ #include <emmintrin.h>
+ #define SIXTEEN_SECOND_LANES_SSE2 1
+#elif !defined(SIXTEEN_SECOND_SCALAR_LANES) && (defined(__aarch64__) || defined(_M_ARM64))
+ #include <arm_neon.h>
+ #define SIXTEEN_SECOND_LANES_NEON 1
+#endif
+
+// Four floats handled as one value, one lane per channel of a frame: the engine's stand-in for
+// juce::dsp::SIMDRegister<float>, usable from the JUCE-free dsp sources. It maps to SSE2 on x86,
+// NEON on 64-bit ARM, and a plain array anywhere else or when SIXTEEN_SECOND_SCALAR_LANES is
+// defined. Every operation is the same IEEE single-precision operation per lane on all three.
+class FloatLanes
+{
+public:
+    static constexpr int size = 4;
+    using Array = std::array<float, size>;
+
+    FloatLanes() : FloatLanes(expand(0.0f)) {}
+
+    static FloatLanes expand(float value)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        return FloatLanes(_mm_set1_ps(value));
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+        return FloatLanes(vdupq_n_f32(value));
+#else
+        return FloatLanes(Native { value, value, value, value });
+#endif
+    }
+
+    // Any alignment.
+    static FloatLanes load(const float* source)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        return FloatLanes(_mm_loadu_ps(source));
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+        return FloatLanes(vld1q_f32(source));
+#else
+        return FloatLanes(Native { source[0], source[1], source[2], source[3] });
+#endif
+    }
+
+    static FloatLanes fromArray(const Array& values) { return load(values.data()); }
+
+    void store(float* destination) const
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        _mm_storeu_ps(destination, value);
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+        vst1q_f32(destination, value);
+#else
+        for (size_t lane = 0; lane < static_cast<size_t>(size); ++lane)
+            destination[lane] = value[lane];
+#endif
+    }
+
+    Array toArray() const
+    {
+        Array values {};
+        store(values.data());
+        return values;
+    }
+
+    friend FloatLanes operator+(FloatLanes a, FloatLanes b)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        return FloatLanes(_mm_add_ps(a.value, b.value));
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+        return FloatLanes(vaddq_f32(a.value, b.value));
+#else
+        return map(a, b, [](float x, float y) { return x + y; });
+#endif
+    }
+
+    friend FloatLanes operator-(FloatLanes a, FloatLanes b)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        return FloatLanes(_mm_sub_ps(a.value, b.value));
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+        return FloatLanes(vsubq_f32(a.value, b.value));
+#else
+        return map(a, b, [](float x, float y) { return x - y; });
+#endif
+    }
+
+    friend FloatLanes operator*(FloatLanes a, FloatLanes b)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        return FloatLanes(_mm_mul_ps(a.value, b.value));
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+        return FloatLanes(vmulq_f32(a.value, b.value));
+#else
+        return map(a, b, [](float x, float y) { return x * y; });
+#endif
+    }
+
+    friend FloatLanes operator/(FloatLanes a, FloatLanes b)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        return FloatLanes(_mm_div_ps(a.value, b.value));
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+        return FloatLanes(vdivq_f32(a.value, b.value));
+#else
+        return map(a, b, [](float x, float y) { return x / y; });
+#endif
+    }
+
+    FloatLanes& operator+=(FloatLanes other) { return *this = *this + other; }
+    FloatLanes& operator-=(FloatLanes other) { return *this = *this - other; }
+    FloatLanes& operator*=(FloatLanes other) { return *this = *this * other; }
+
+    // b where either lane is NaN, as minps/maxps do.
+    static FloatLanes min(FloatLanes a, FloatLanes b)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        return FloatLanes(_mm_min_ps(a.value, b.value));
+#else
+        return selectGreater(b, a, a, b);
+#endif
+    }
+
+    static FloatLanes max(FloatLanes a, FloatLanes b)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        return FloatLanes(_mm_max_ps(a.value, b.value));
+#else
+        return selectGreater(a, b, a, b);
+#endif
+    }
+
+    static FloatLanes abs(FloatLanes a)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        return FloatLanes(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.value));
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+        return FloatLanes(vabsq_f32(a.value));
+#else
+        return map(a, a, [](float x, float) { return std::abs(x); });
+#endif
+    }
+
+    // Per lane: a > b ? ifGreater : otherwise.
+    static FloatLanes selectGreater(FloatLanes a, FloatLanes b, FloatLanes ifGreater, FloatLanes otherwise)
+    {
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+        const auto mask = _mm_cmpgt_ps(a.value, b.value);
+        return FloatLanes(_mm_or_ps(_mm_and_ps(mask, ifGreater.value), _mm_andnot_ps(mask, otherwise.value)));
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+        return FloatLanes(vbslq_f32(vcgtq_f32(a.value, b.value), ifGreater.value, otherwise.value));
+#else
+        Native result {};
+        for (size_t lane = 0; lane < static_cast<size_t>(size); ++lane)
+            result[lane] = a.value[lane] > b.value[lane] ? ifGreater.value[lane] : otherwise.value[lane];
+        return FloatLanes(result);
+#endif
+    }
+
+private:
+#if defined(SIXTEEN_SECOND_LANES_SSE2)
+    using Native = __m128;
+#elif defined(SIXTEEN_SECOND_LANES_NEON)
+    using Native = float32x4_t;
+#else
+    using Native = Array;
+
+    template <typename Function>
+    static FloatLanes map(FloatLanes a, FloatLanes b, Function function)
+    {
+        Native result {};
+        for (size_t lane = 0; lane < static_cast<size_t>(size); ++lane)
+            result[lane] = function(a.value[lane], b.value[lane]);
+        return FloatLanes(result);
+    }
+#endif
+
+    explicit FloatLanes(Native native) : value(native) {}
+
+    Native value;
+};
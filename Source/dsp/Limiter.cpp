@@ -6,13 +6,13 @@
 void Limiter::reset(double newSampleRate)
 {
     sampleRate = (newSampleRate > 0.0) ? newSampleRate : 44100.0;
-    envelope = 0.0f;
+    envelope = {};
     updateCoefficients();
 }
 
 void Limiter::setThreshold(float newThreshold)
 {
-    threshold = std::clamp(newThreshold, 0.01f, 1.0f);
+    threshold = FloatLanes::expand(std::clamp(newThreshold, 0.01f, 1.0f));
 }
 
 void Limiter::setAttackMs(float newAttackMs)
@@ -29,16 +29,11 @@ void Limiter::setReleaseMs(float newReleaseMs)
 
 float Limiter::process(float input)
 {
-    const auto absSample = std::abs(input);
-
-    const auto coeff = (absSample > envelope) ? attackCoeff : releaseCoeff;
-    envelope = coeff * envelope + (1.0f - coeff) * absSample;
-
-    if (envelope <= threshold)
-        return input;
-
-    const auto gain = threshold / envelope;
-    return input * gain;
+    auto envelopes = envelope.toArray();
+    const auto output = process(FloatLanes::fromArray({ input, 0.0f, 0.0f, 0.0f })).toArray();
+    envelopes[0] = envelope.toArray()[0];
+    envelope = FloatLanes::fromArray(envelopes);
+    return output[0];
 }
 
 void Limiter::updateCoefficients()
@@ -46,6 +41,6 @@ void Limiter::updateCoefficients()
     const auto attackSamples = std::max(1.0f, attackMs * 0.001f * static_cast<float>(sampleRate));
     const auto releaseSamples = std::max(1.0f, releaseMs * 0.001f * static_cast<float>(sampleRate));
 
-    attackCoeff = std::exp(-1.0f / attackSamples);
-    releaseCoeff = std::exp(-1.0f / releaseSamples);
+    attackCoeff = FloatLanes::expand(std::exp(-1.0f / attackSamples));
+    releaseCoeff = FloatLanes::expand(std::exp(-1.0f / releaseSamples));
 }
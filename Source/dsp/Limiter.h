@@ -1,5 +1,8 @@
 #pragma once
 
+#include "FloatLanes.h"
+
+// Peak limiter with one envelope per lane, so a whole frame of channels is limited in one pass.
 class Limiter
 {
 public:
@@ -8,16 +11,29 @@ public:
     void setAttackMs(float newAttackMs);
     void setReleaseMs(float newReleaseMs);
 
+    // A single channel on lane 0; the other lanes keep their envelopes.
     float process(float input);
 
+    // One channel per lane, each against its own envelope.
+    FloatLanes process(FloatLanes input)
+    {
+        const auto one = FloatLanes::expand(1.0f);
+        const auto level = FloatLanes::abs(input);
+        const auto coeff = FloatLanes::selectGreater(level, envelope, attackCoeff, releaseCoeff);
+        envelope = coeff * envelope + (one - coeff) * level;
+
+        // Above the threshold the gain pulls the envelope back down to it.
+        return input * FloatLanes::selectGreater(envelope, threshold, threshold / envelope, one);
+    }
+
 private:
     void updateCoefficients();
 
     double sampleRate = 44100.0;
-    float threshold = 0.98f;
     float attackMs = 1.0f;
     float releaseMs = 50.0f;
-    float envelope = 0.0f;
-    float attackCoeff = 1.0f;
-    float releaseCoeff = 1.0f;
+    FloatLanes threshold = FloatLanes::expand(0.98f);
+    FloatLanes envelope;
+    FloatLanes attackCoeff = FloatLanes::expand(1.0f);
+    FloatLanes releaseCoeff = FloatLanes::expand(1.0f);
 };
@@ -0,0 +1,65 @@
+#include "LoopImportStream.h"
+
+bool LoopImportStream::begin(int channels, int frames, double rate)
+{
+    if (getState() != State::Idle || channels <= 0 || frames <= 0)
+        return false;
+
+    numChannels = channels;
+    totalFrames = frames;
+    sampleRate = rate;
+    slots.assign(static_cast<size_t>(numSlots * channels * pageSize), 0.0f);
+    published.store(0, std::memory_order_relaxed);
+    consumed.store(0, std::memory_order_relaxed);
+    state.store(State::Streaming, std::memory_order_release);
+    return true;
+}
+
+float* LoopImportStream::acquire()
+{
+    const auto next = published.load(std::memory_order_relaxed);
+    if (next - consumed.load(std::memory_order_acquire) >= static_cast<std::uint32_t>(numSlots))
+        return nullptr;
+
+    return slots.data() + static_cast<size_t>((next % numSlots) * numChannels * pageSize);
+}
+
+void LoopImportStream::publish(int frames)
+{
+    const auto next = published.load(std::memory_order_relaxed);
+    slotFrames[next % numSlots] = frames;
+    published.store(next + 1, std::memory_order_release);
+}
+
+void LoopImportStream::close()
+{
+    std::vector<float>().swap(slots);
+    numChannels = 0;
+    totalFrames = 0;
+    state.store(State::Idle, std::memory_order_release);
+}
+
+const float* LoopImportStream::peek(int& frames) const
+{
+    const auto next = consumed.load(std::memory_order_relaxed);
+    if (next == published.load(std::memory_order_acquire))
+        return nullptr;
+
+    frames = slotFrames[next % numSlots];
+    return slots.data() + static_cast<size_t>((next % numSlots) * numChannels * pageSize);
+}
+
+void LoopImportStream::pop()
+{
+    consumed.store(consumed.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void LoopImportStream::complete()
+{
+    state.store(State::Complete, std::memory_order_release);
+}
+
+void LoopImportStream::cancel()
+{
+    state.store(State::Cancelled, std::memory_order_release);
+}
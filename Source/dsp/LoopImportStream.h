@@ -0,0 +1,61 @@
+#pragma once
+
+#include "MemoryBuffer.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Hands converted audio from an import thread to the audio thread a page at a time. The producer
+// opens a stream of known length, then fills and publishes pages in a small ring; the audio
+// thread copies published pages into the delay memory and hands the slots back. Neither side
+// locks or waits for the other, and the audio thread never allocates.
+class LoopImportStream
+{
+public:
+    static constexpr int pageSize = MemoryBuffer::pageSize;
+    static constexpr int numSlots = 16;
+
+    enum class State
+    {
+        Idle,
+        Streaming,
+        // Every frame has been consumed.
+        Complete,
+        // The consumer gave up; the producer should stop and close.
+        Cancelled
+    };
+
+    // Producer. Allocates the ring and opens a stream of totalFrames frames; false unless Idle.
+    bool begin(int channels, int totalFrames, double sampleRate);
+    // Producer. The slot for the next page (channel c starts at c * pageSize), or null while the
+    // ring is full.
+    float* acquire();
+    // Producer. Publishes the acquired slot holding `frames` frames.
+    void publish(int frames);
+    // Producer, once Complete or Cancelled: frees the ring and returns to Idle.
+    void close();
+
+    State getState() const { return state.load(std::memory_order_acquire); }
+    int getNumChannels() const { return numChannels; }
+    int getTotalFrames() const { return totalFrames; }
+    double getSampleRate() const { return sampleRate; }
+
+    // Consumer. The oldest published page and its frame count, or null when none is waiting.
+    const float* peek(int& frames) const;
+    // Consumer. Returns the page from peek() to the producer.
+    void pop();
+    void complete();
+    void cancel();
+
+private:
+    std::atomic<State> state { State::Idle };
+    std::atomic<std::uint32_t> published { 0 };
+    std::atomic<std::uint32_t> consumed { 0 };
+    int numChannels = 0;
+    int totalFrames = 0;
+    double sampleRate = 0.0;
+    std::vector<float> slots;
+    std::array<int, numSlots> slotFrames {};
+};
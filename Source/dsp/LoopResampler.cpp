@@ -0,0 +1,175 @@
+#include "LoopResampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr int kHalfTaps = LoopResampler::numTaps / 2;
+    constexpr double kCutoffs[LoopResampler::numTables] = { 1.0, 1.0 / 1.5, 0.5 };
+    constexpr double kKaiserBeta = 8.0;
+
+    double besselI0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        const auto halfX = x * 0.5;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+        }
+        return sum;
+    }
+
+    int wrapIndex(int index, int size)
+    {
+        index %= size;
+        return index < 0 ? index + size : index;
+    }
+
+    float loadSample(const float* data, int index, const SampleCodec&) { return data[index]; }
+
+    float loadSample(const std::int16_t* data, int index, const SampleCodec& codec)
+    {
+        return codec.unpack(data[index]);
+    }
+}
+
+void LoopResampler::prepare()
+{
+    if (!tables.empty())
+        return;
+
+    tables.assign(static_cast<size_t>(numTables * numPhases * numTaps), 0.0f);
+    const auto windowNorm = besselI0(kKaiserBeta);
+    constexpr double kPi = 3.14159265358979323846;
+
+    for (int table = 0; table < numTables; ++table)
+    {
+        const auto cutoff = kCutoffs[table];
+        for (int phase = 0; phase < numPhases; ++phase)
+        {
+            const auto fraction = static_cast<double>(phase) / numPhases;
+            auto* taps = tables.data() + static_cast<size_t>((table * numPhases + phase) * numTaps);
+            double sum = 0.0;
+            double coefficients[numTaps];
+
+            for (int k = 0; k < numTaps; ++k)
+            {
+                const auto x = static_cast<double>(k - (kHalfTaps - 1)) - fraction;
+                const auto arg = kPi * cutoff * x;
+                const auto sinc = std::abs(x) < 1.0e-12 ? 1.0 : std::sin(arg) / arg;
+                const auto ratio = x / static_cast<double>(kHalfTaps);
+                const auto window = std::abs(ratio) >= 1.0
+                                        ? 0.0
+                                        : besselI0(kKaiserBeta * std::sqrt(1.0 - ratio * ratio)) / windowNorm;
+                coefficients[k] = cutoff * sinc * window;
+                sum += coefficients[k];
+            }
+
+            for (int k = 0; k < numTaps; ++k)
+                taps[k] = static_cast<float>(coefficients[k] / sum);
+        }
+    }
+}
+
+float LoopResampler::readLoop(const LoopView& loop, int loopIndex)
+{
+    const auto index = wrapIndex(loop.loopStart + wrapIndex(loopIndex, loop.loopLength), loop.bufferSize);
+    return loop.packed != nullptr ? loop.codec.unpack(loop.packed[index]) : loop.data[index];
+}
+
+const float* LoopResampler::getTable(double rate) const
+{
+    const auto speed = std::abs(rate);
+    const auto table = speed <= 1.0 ? 0 : (speed <= 1.5 ? 1 : 2);
+    return tables.data() + static_cast<size_t>(table * numPhases * numTaps);
+}
+
+void LoopResampler::process(const LoopView& loop,
+                            const int* indices,
+                            const float* fractions,
+                            float* dest,
+                            int numSamples,
+                            Quality quality,
+                            double rate) const
+{
+    if ((loop.data == nullptr && loop.packed == nullptr) || loop.loopLength <= 0 || loop.bufferSize <= 0)
+    {
+        std::fill(dest, dest + numSamples, 0.0f);
+        return;
+    }
+
+    if (quality == Quality::Sinc && tables.empty())
+        quality = Quality::Linear;
+
+    if (loop.packed != nullptr)
+        processStorage(loop, loop.packed, indices, fractions, dest, numSamples, quality, rate);
+    else
+        processStorage(loop, loop.data, indices, fractions, dest, numSamples, quality, rate);
+}
+
+template <typename Sample>
+void LoopResampler::processStorage(const LoopView& loop,
+                                   const Sample* data,
+                                   const int* indices,
+                                   const float* fractions,
+                                   float* dest,
+                                   int numSamples,
+                                   Quality quality,
+                                   double rate) const
+{
+    const auto read = [&loop, data](int loopIndex)
+    {
+        const auto index = wrapIndex(loop.loopStart + wrapIndex(loopIndex, loop.loopLength), loop.bufferSize);
+        return loadSample(data, index, loop.codec);
+    };
+
+    if (quality == Quality::Nearest)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = read(indices[i]);
+        return;
+    }
+
+    if (quality == Quality::Linear)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto a = read(indices[i]);
+            const auto b = read(indices[i] + 1);
+            dest[i] = a + (b - a) * fractions[i];
+        }
+        return;
+    }
+
+    const auto* table = getTable(rate);
+    const auto loopEndsInBuffer = loop.loopStart + loop.loopLength <= loop.bufferSize;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto phase = std::min(numPhases - 1, static_cast<int>(fractions[i] * numPhases + 0.5f));
+        const auto first = indices[i] - (kHalfTaps - 1);
+        const auto* taps = table + static_cast<size_t>(phase * numTaps);
+
+        float window[numTaps];
+        if (loopEndsInBuffer && first >= 0 && first + numTaps <= loop.loopLength)
+        {
+            // Fast path: the whole kernel lies in one contiguous run of the buffer.
+            const auto* source = data + loop.loopStart + first;
+            for (int k = 0; k < numTaps; ++k)
+                window[k] = loadSample(source, k, loop.codec);
+        }
+        else
+        {
+            for (int k = 0; k < numTaps; ++k)
+                window[k] = read(first + k);
+        }
+
+        float sum = 0.0f;
+        for (int k = 0; k < numTaps; ++k)
+            sum += window[k] * taps[k];
+        dest[i] = sum;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "SampleCodec.h"
+
+#include <cstdint>
+#include <vector>
+
+// Reads a loop region of a circular buffer at fractional positions. The loop may itself wrap
+// around the end of the buffer; taps that cross the loop end continue from the loop start.
+// Integer-format buffers are read through `packed` and `codec` instead of `data`.
+struct LoopView
+{
+    const float* data = nullptr;
+    int bufferSize = 0;
+    int loopStart = 0;
+    int loopLength = 0;
+    const std::int16_t* packed = nullptr;
+    SampleCodec codec {};
+};
+
+class LoopResampler
+{
+public:
+    enum class Quality
+    {
+        Nearest,
+        Linear,
+        Sinc
+    };
+
+    static constexpr int numTaps = 16;
+    static constexpr int numPhases = 256;
+    static constexpr int numTables = 3;
+
+    // Builds the coefficient tables (allocates; call off the audio thread).
+    void prepare();
+    bool isPrepared() const { return !tables.empty(); }
+
+    // `rate` is the playback rate for the chunk; above 1x a lower-cutoff table is used.
+    void process(const LoopView& loop,
+                 const int* indices,
+                 const float* fractions,
+                 float* dest,
+                 int numSamples,
+                 Quality quality,
+                 double rate) const;
+
+    static float readLoop(const LoopView& loop, int loopIndex);
+
+private:
+    const float* getTable(double rate) const;
+
+    template <typename Sample>
+    void processStorage(const LoopView& loop, const Sample* data, const int* indices, const float* fractions,
+                        float* dest, int numSamples, Quality quality, double rate) const;
+
+    std::vector<float> tables;
+};
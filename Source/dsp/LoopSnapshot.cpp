@@ -0,0 +1,159 @@
+#include "LoopSnapshot.h"
+
+#include <algorithm>
+
+bool LoopSnapshot::request(int channels, int maxFrames)
+{
+    if (state.load(std::memory_order_acquire) != State::Idle || channels <= 0 || maxFrames <= 0)
+        return false;
+
+    capacity = maxFrames;
+    numChannels = channels;
+    frames.assign(static_cast<size_t>(channels) * static_cast<size_t>(maxFrames), 0.0f);
+    copied.assign(static_cast<size_t>((maxFrames + pageSize - 1) / pageSize), 0);
+    cancelRequested.store(false, std::memory_order_relaxed);
+    state.store(State::Requested, std::memory_order_release);
+    return true;
+}
+
+void LoopSnapshot::release()
+{
+    std::vector<float>().swap(frames);
+    std::vector<std::uint8_t>().swap(copied);
+    capacity = 0;
+    length = 0;
+    state.store(State::Idle, std::memory_order_release);
+}
+
+void LoopSnapshot::cancel()
+{
+    auto expected = State::Requested;
+    if (!state.compare_exchange_strong(expected, State::Abandoned, std::memory_order_acq_rel))
+        cancelRequested.store(true, std::memory_order_release);
+}
+
+const float* LoopSnapshot::getChannel(int channel) const
+{
+    if (channel < 0 || channel >= numChannels)
+        return nullptr;
+
+    return frames.data() + static_cast<size_t>(channel) * static_cast<size_t>(capacity);
+}
+
+void LoopSnapshot::advance(const MemoryBuffer& memory, int newLoopStart, int loopLength, double rate, int maxPages)
+{
+    advanceCount.store(advanceCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (copying && cancelRequested.load(std::memory_order_acquire))
+    {
+        abandon();
+        return;
+    }
+
+    if (!copying)
+    {
+        // The reader may cancel a request at any point, so it is only ever taken over by exchange.
+        auto expected = State::Requested;
+        if (state.load(std::memory_order_acquire) != expected)
+            return;
+
+        if (loopLength <= 0 || loopLength > capacity || loopLength > memory.getSize())
+        {
+            state.compare_exchange_strong(expected, State::Failed, std::memory_order_acq_rel);
+            return;
+        }
+
+        if (!state.compare_exchange_strong(expected, State::Copying, std::memory_order_acq_rel))
+            return;
+
+        loopStart = newLoopStart;
+        length = loopLength;
+        sampleRate = rate;
+        numPages = (length + pageSize - 1) / pageSize;
+        pagesLeft = numPages;
+        nextPage = 0;
+        copying = true;
+    }
+
+    for (; maxPages > 0 && pagesLeft > 0; ++nextPage)
+    {
+        if (copied[static_cast<size_t>(nextPage)] == 0)
+        {
+            copyPage(memory, nextPage);
+            --maxPages;
+        }
+    }
+
+    if (pagesLeft == 0)
+        complete();
+}
+
+void LoopSnapshot::protect(const MemoryBuffer& memory, int start, int count)
+{
+    if (!copying || count <= 0)
+        return;
+
+    const auto size = memory.getSize();
+    count = std::min(count, size);
+    auto offset = (start - loopStart) % size;
+    if (offset < 0)
+        offset += size;
+
+    // The span in loop offsets, split where it runs past the end of the buffer.
+    const auto end = offset + count;
+    if (offset < length)
+        protectRange(memory, offset, std::min(end, length) - 1);
+    if (end > size)
+        protectRange(memory, 0, std::min(end - size, length) - 1);
+
+    if (pagesLeft == 0)
+        complete();
+}
+
+void LoopSnapshot::finish(const MemoryBuffer& memory)
+{
+    if (!copying)
+        return;
+
+    protectRange(memory, 0, length - 1);
+    complete();
+}
+
+void LoopSnapshot::abandon()
+{
+    if (!copying)
+        return;
+
+    copying = false;
+    state.store(State::Abandoned, std::memory_order_release);
+}
+
+void LoopSnapshot::protectRange(const MemoryBuffer& memory, int first, int last)
+{
+    for (int page = first / pageSize; page <= last / pageSize; ++page)
+    {
+        if (copied[static_cast<size_t>(page)] == 0)
+            copyPage(memory, page);
+    }
+}
+
+void LoopSnapshot::copyPage(const MemoryBuffer& memory, int page)
+{
+    const auto offset = page * pageSize;
+    const auto count = std::min(pageSize, length - offset);
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* dest = frames.data() + static_cast<size_t>(channel) * static_cast<size_t>(capacity)
+                     + static_cast<size_t>(offset);
+        memory.readBlock(channel, loopStart + offset, dest, count);
+    }
+
+    copied[static_cast<size_t>(page)] = 1;
+    --pagesLeft;
+}
+
+void LoopSnapshot::complete()
+{
+    copying = false;
+    state.store(State::Complete, std::memory_order_release);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "MemoryBuffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// A frozen copy of the loop, taken while the engine keeps writing. The audio thread freezes the
+// loop's position at a block boundary, then copies it page by page: a few pages at the end of
+// each block, and any page the engine is about to overwrite first (copy on write). The result is
+// the loop exactly as it was at the freeze, however long the copy takes.
+class LoopSnapshot
+{
+public:
+    static constexpr int pageSize = MemoryBuffer::pageSize;
+
+    enum class State
+    {
+        Idle,
+        Requested,
+        Copying,
+        Complete,
+        // No loop, or one longer than the room requested.
+        Failed,
+        // The memory was replaced before the copy completed.
+        Abandoned
+    };
+
+    // Message thread. Allocates room for up to maxFrames frames and asks the audio thread for a
+    // snapshot; false if one is already in progress.
+    bool request(int channels, int maxFrames);
+    // Reader thread, once the copy has completed or failed: frees the copy and returns to Idle.
+    void release();
+    // Reader thread, when the audio thread has stopped calling. A request not yet picked up is
+    // Abandoned at once; a copy under way is abandoned at the next advance(), since until then
+    // the audio thread may still be writing into it.
+    void cancel();
+
+    State getState() const { return state.load(std::memory_order_acquire); }
+    // Calls to advance() so far: a reader polling the state can tell a slow copy from an audio
+    // thread that is no longer running.
+    std::uint32_t getAdvanceCount() const { return advanceCount.load(std::memory_order_relaxed); }
+
+    // Valid while Complete.
+    int getNumChannels() const { return numChannels; }
+    int getLength() const { return length; }
+    double getSampleRate() const { return sampleRate; }
+    const float* getChannel(int channel) const;
+
+    // Audio thread, at block boundaries. Freezes the loop if a snapshot was requested (failing
+    // when there is none or it does not fit), then copies up to maxPages pages.
+    void advance(const MemoryBuffer& memory, int loopStart, int loopLength, double rate, int maxPages);
+    // Audio thread, before `count` samples from buffer index `start` are written.
+    void protect(const MemoryBuffer& memory, int start, int count);
+    // Audio thread, before the memory is cleared or replaced: copies whatever is left.
+    void finish(const MemoryBuffer& memory);
+    // Audio thread, when the memory is swapped out from under the copy.
+    void abandon();
+
+private:
+    void protectRange(const MemoryBuffer& memory, int first, int last);
+    void copyPage(const MemoryBuffer& memory, int page);
+    void complete();
+
+    std::atomic<State> state { State::Idle };
+    std::atomic<bool> cancelRequested { false };
+    std::atomic<std::uint32_t> advanceCount { 0 };
+    int capacity = 0;
+    int numChannels = 0;
+    std::vector<float> frames;
+    std::vector<std::uint8_t> copied;
+
+    // Audio thread while Copying.
+    bool copying = false;
+    int loopStart = 0;
+    int length = 0;
+    int numPages = 0;
+    int pagesLeft = 0;
+    int nextPage = 0;
+    double sampleRate = 0.0;
+};
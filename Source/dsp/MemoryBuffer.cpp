@@ -3,20 +3,190 @@
 #include <algorithm>
 #include <cmath>
 
-void MemoryBuffer::prepare(int channels, int sizeInSamples)
+namespace
+{
+    float loadSample(const float* channelData, int index, const SampleCodec&) { return channelData[index]; }
+
+    float loadSample(const std::int16_t* channelData, int index, const SampleCodec& codec)
+    {
+        return codec.unpack(channelData[index]);
+    }
+
+    template <typename Sample>
+    void readLinearRuns(const Sample* channelData, int size, int index, float frac, float* dest, int numSamples,
+                        const SampleCodec& codec)
+    {
+        auto done = 0;
+        while (done < numSamples)
+        {
+            const auto run = std::min(numSamples - done, size - 1 - index);
+            auto* out = dest + done;
+            for (int i = 0; i < run; ++i)
+            {
+                const auto a = loadSample(channelData, index + i, codec);
+                out[i] = a + (loadSample(channelData, index + i + 1, codec) - a) * frac;
+            }
+
+            done += run;
+            index += run;
+
+            if (done < numSamples)
+            {
+                const auto last = loadSample(channelData, size - 1, codec);
+                dest[done++] = last + (loadSample(channelData, 0, codec) - last) * frac;
+                index = 0;
+            }
+        }
+    }
+}
+
+void MemoryBuffer::prepare(int channels, int sizeInSamples, SampleFormat newFormat)
 {
     numChannels = std::max(1, channels);
     size = std::max(1, sizeInSamples);
     writeIndex = 0;
-    data.assign(static_cast<size_t>(numChannels * size), 0.0f);
+    format = newFormat;
+    codec = SampleCodec::forFormat(format);
+
+    const auto total = static_cast<size_t>(numChannels * size);
+    if (isPacked())
+    {
+        std::vector<float>().swap(data);
+        words.assign(total, 0);
+    }
+    else
+    {
+        std::vector<std::int16_t>().swap(words);
+        data.assign(total, 0.0f);
+    }
+}
+
+void MemoryBuffer::setFormat(SampleFormat newFormat)
+{
+    if (newFormat == format)
+        return;
+
+    const auto newCodec = SampleCodec::forFormat(newFormat);
+    const auto total = static_cast<int>(std::max(data.size(), words.size()));
+
+    if (newFormat == SampleFormat::Float32)
+    {
+        data.resize(static_cast<size_t>(total));
+        codec.unpackBlock(words.data(), data.data(), total);
+        std::vector<std::int16_t>().swap(words);
+    }
+    else if (isPacked())
+    {
+        for (auto& word : words)
+            word = newCodec.pack(codec.unpack(word));
+    }
+    else
+    {
+        words.resize(static_cast<size_t>(total));
+        newCodec.packBlock(data.data(), words.data(), total);
+        std::vector<float>().swap(data);
+    }
+
+    format = newFormat;
+    codec = newCodec;
 }
 
 void MemoryBuffer::clear()
 {
     std::fill(data.begin(), data.end(), 0.0f);
+    std::fill(words.begin(), words.end(), static_cast<std::int16_t>(0));
     writeIndex = 0;
 }
 
+void MemoryBuffer::swap(MemoryBuffer& other) noexcept
+{
+    std::swap(numChannels, other.numChannels);
+    std::swap(size, other.size);
+    std::swap(writeIndex, other.writeIndex);
+    std::swap(format, other.format);
+    std::swap(codec, other.codec);
+    data.swap(other.data);
+    words.swap(other.words);
+}
+
+void MemoryBuffer::copyFrom(const MemoryBuffer& source, int sourceStart, int count)
+{
+    if (source.size <= 0 || size <= 0)
+        return;
+
+    count = std::min({ count, size, source.size });
+    auto start = sourceStart % source.size;
+    if (start < 0)
+        start += source.size;
+
+    const auto channels = std::min(numChannels, source.numChannels);
+    const auto first = std::min(count, source.size - start);
+    const int runStarts[] = { start, 0 };
+    const int runLengths[] = { first, count - first };
+
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        const auto sourceOffset = static_cast<size_t>(channel * source.size);
+        auto dest = static_cast<size_t>(channel * size);
+
+        for (int run = 0; run < 2; ++run)
+        {
+            const auto from = sourceOffset + static_cast<size_t>(runStarts[run]);
+            const auto length = runLengths[run];
+
+            if (!source.isPacked() && !isPacked())
+                std::copy_n(source.data.data() + from, length, data.data() + dest);
+            else if (!source.isPacked())
+                codec.packBlock(source.data.data() + from, words.data() + dest, length);
+            else if (!isPacked())
+                source.codec.unpackBlock(source.words.data() + from, data.data() + dest, length);
+            else if (source.format == format)
+                std::copy_n(source.words.data() + from, length, words.data() + dest);
+            else
+            {
+                const auto* in = source.words.data() + from;
+                auto* out = words.data() + dest;
+                for (int i = 0; i < length; ++i)
+                    out[i] = codec.pack(source.codec.unpack(in[i]));
+            }
+
+            dest += static_cast<size_t>(length);
+        }
+    }
+}
+
+void MemoryBuffer::clearPages(int index, int length)
+{
+    if (size <= 0 || length <= 0)
+        return;
+
+    auto start = index % size;
+    if (start < 0)
+        start += size;
+
+    const auto firstPage = start / pageSize;
+    const auto lastPage = (start + std::min(length, size) - 1) / pageSize;
+    const auto pageStart = firstPage * pageSize;
+    const auto pageLength = std::min(size, (lastPage - firstPage + 1) * pageSize);
+
+    const auto first = std::min(pageLength, size - pageStart);
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        if (isPacked())
+        {
+            auto* channelData = words.data() + static_cast<size_t>(channel * size);
+            std::fill(channelData + pageStart, channelData + pageStart + first, static_cast<std::int16_t>(0));
+            std::fill(channelData, channelData + (pageLength - first), static_cast<std::int16_t>(0));
+        }
+        else
+        {
+            auto* channelData = data.data() + static_cast<size_t>(channel * size);
+            std::fill(channelData + pageStart, channelData + pageStart + first, 0.0f);
+            std::fill(channelData, channelData + (pageLength - first), 0.0f);
+        }
+    }
+}
+
 void MemoryBuffer::setWriteIndex(int index)
 {
     if (size <= 0)
@@ -52,8 +222,7 @@ float MemoryBuffer::readSample(int channel, int index) const
     if (wrappedIndex < 0)
         wrappedIndex += size;
 
-    const auto offset = static_cast<size_t>(channel * size + wrappedIndex);
-    return data[offset];
+    return load(static_cast<size_t>(channel * size + wrappedIndex));
 }
 
 float MemoryBuffer::readSampleLinear(int channel, float index) const
@@ -74,6 +243,25 @@ float MemoryBuffer::readSampleLinear(int channel, float index) const
     return sampleA + (sampleB - sampleA) * frac;
 }
 
+void MemoryBuffer::readLinearBlock(int channel, double position, float* dest, int numSamples) const
+{
+    if (size <= 0 || channel < 0 || channel >= numChannels)
+    {
+        std::fill(dest, dest + std::max(0, numSamples), 0.0f);
+        return;
+    }
+
+    position -= std::floor(position / size) * size;
+    auto index = std::min(static_cast<int>(position), size - 1);
+    const auto frac = static_cast<float>(position - index);
+    const auto offset = static_cast<size_t>(channel * size);
+
+    if (isPacked())
+        readLinearRuns(words.data() + offset, size, index, frac, dest, numSamples, codec);
+    else
+        readLinearRuns(data.data() + offset, size, index, frac, dest, numSamples, codec);
+}
+
 void MemoryBuffer::writeSample(int channel, int index, float value)
 {
     if (size <= 0 || numChannels <= 0)
@@ -87,5 +275,96 @@ void MemoryBuffer::writeSample(int channel, int index, float value)
         wrappedIndex += size;
 
     const auto offset = static_cast<size_t>(channel * size + wrappedIndex);
-    data[offset] = value;
+    if (isPacked())
+        words[offset] = codec.pack(value);
+    else
+        data[offset] = value;
+}
+
+void MemoryBuffer::writeBlock(int channel, int index, const float* source, int numSamples)
+{
+    if (size <= 0 || channel < 0 || channel >= numChannels || numSamples <= 0)
+        return;
+
+    if (numSamples > size)
+    {
+        index += numSamples - size;
+        source += numSamples - size;
+        numSamples = size;
+    }
+
+    auto start = index % size;
+    if (start < 0)
+        start += size;
+
+    const auto first = std::min(numSamples, size - start);
+    if (isPacked())
+    {
+        auto* channelData = words.data() + static_cast<size_t>(channel * size);
+        codec.packBlock(source, channelData + start, first);
+        codec.packBlock(source + first, channelData, numSamples - first);
+    }
+    else
+    {
+        auto* channelData = data.data() + static_cast<size_t>(channel * size);
+        std::copy(source, source + first, channelData + start);
+        std::copy(source + first, source + numSamples, channelData);
+    }
+}
+
+void MemoryBuffer::readBlock(int channel, int index, float* dest, int numSamples) const
+{
+    if (size <= 0 || channel < 0 || channel >= numChannels || numSamples <= 0)
+        return;
+
+    auto start = index % size;
+    if (start < 0)
+        start += size;
+
+    // Longer reads come round again, like readSample() would.
+    while (numSamples > 0)
+    {
+        const auto run = std::min(numSamples, size - start);
+        const auto offset = static_cast<size_t>(channel * size + start);
+        if (isPacked())
+            codec.unpackBlock(words.data() + offset, dest, run);
+        else
+            std::copy(data.data() + offset, data.data() + offset + static_cast<size_t>(run), dest);
+
+        dest += run;
+        numSamples -= run;
+        start = 0;
+    }
+}
+
+float* MemoryBuffer::getWritePointer(int channel)
+{
+    if (isPacked() || size <= 0 || channel < 0 || channel >= numChannels)
+        return nullptr;
+
+    return data.data() + static_cast<size_t>(channel * size);
+}
+
+const float* MemoryBuffer::getReadPointer(int channel) const
+{
+    if (isPacked() || size <= 0 || channel < 0 || channel >= numChannels)
+        return nullptr;
+
+    return data.data() + static_cast<size_t>(channel * size);
+}
+
+std::int16_t* MemoryBuffer::getPackedWritePointer(int channel)
+{
+    if (!isPacked() || size <= 0 || channel < 0 || channel >= numChannels)
+        return nullptr;
+
+    return words.data() + static_cast<size_t>(channel * size);
+}
+
+const std::int16_t* MemoryBuffer::getPackedReadPointer(int channel) const
+{
+    if (!isPacked() || size <= 0 || channel < 0 || channel >= numChannels)
+        return nullptr;
+
+    return words.data() + static_cast<size_t>(channel * size);
 }
@@ -1,15 +1,33 @@
 #pragma once
 
+#include "SampleCodec.h"
+
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 class MemoryBuffer
 {
 public:
-    void prepare(int channels, int sizeInSamples);
+    static constexpr int pageSize = 4096;
+
+    void prepare(int channels, int sizeInSamples, SampleFormat newFormat = SampleFormat::Float32);
+    // Converts the stored audio to another format in place, keeping the write head (allocates).
+    void setFormat(SampleFormat newFormat);
     void clear();
+    void clearPages(int index, int length);
+    // Exchanges storage, layout and write head without allocating.
+    void swap(MemoryBuffer& other) noexcept;
+    // Copies `count` samples per channel starting at sourceStart (wrapping in the source) to the
+    // start of this buffer, converting formats as needed. Channels the source lacks stay silent.
+    void copyFrom(const MemoryBuffer& source, int sourceStart, int count);
 
     int getSize() const { return size; }
     int getNumChannels() const { return numChannels; }
+    SampleFormat getFormat() const { return format; }
+    bool isPacked() const { return format != SampleFormat::Float32; }
+    const SampleCodec& getCodec() const { return codec; }
+    size_t getMemoryBytes() const { return data.size() * sizeof(float) + words.size() * sizeof(std::int16_t); }
 
     int getWriteIndex() const { return writeIndex; }
     void setWriteIndex(int index);
@@ -17,11 +35,29 @@ public:
 
     float readSample(int channel, int index) const;
     float readSampleLinear(int channel, float index) const;
+    // Linear reads of numSamples consecutive positions from `position`, split at the wrap point.
+    void readLinearBlock(int channel, double position, float* dest, int numSamples) const;
     void writeSample(int channel, int index, float value);
+    // Bulk copy of numSamples values starting at index, split at the wrap point.
+    void writeBlock(int channel, int index, const float* source, int numSamples);
+    // Bulk read of numSamples values starting at index into dest, split at the wrap point.
+    void readBlock(int channel, int index, float* dest, int numSamples) const;
+
+    // Raw channel storage: the float pointers exist for Float32 only, the word pointers for the
+    // integer formats; the other pair returns null.
+    const float* getReadPointer(int channel) const;
+    float* getWritePointer(int channel);
+    const std::int16_t* getPackedReadPointer(int channel) const;
+    std::int16_t* getPackedWritePointer(int channel);
 
 private:
+    float load(size_t offset) const { return isPacked() ? codec.unpack(words[offset]) : data[offset]; }
+
     int numChannels = 0;
     int size = 0;
     int writeIndex = 0;
+    SampleFormat format = SampleFormat::Float32;
+    SampleCodec codec;
     std::vector<float> data;
+    std::vector<std::int16_t> words;
 };
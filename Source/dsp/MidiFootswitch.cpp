@@ -0,0 +1,147 @@
+#include "MidiFootswitch.h"
+
+#include <cstddef>
+
+MidiFootswitchMap::MidiFootswitchMap()
+{
+    resetToDefaults();
+}
+
+void MidiFootswitchMap::resetToDefaults()
+{
+    for (int i = 0; i < numActions; ++i)
+    {
+        FootswitchBinding binding;
+        binding.kind = FootswitchBinding::Kind::Controller;
+        binding.channel = 0;
+        binding.number = defaultFirstController + i;
+        bindings[static_cast<size_t>(i)].store(pack(binding));
+    }
+}
+
+void MidiFootswitchMap::setBinding(FootswitchAction action, FootswitchBinding binding)
+{
+    const auto index = static_cast<int>(action);
+    if (index < 0 || index >= numActions)
+        return;
+
+    bindings[static_cast<size_t>(index)].store(pack(binding));
+}
+
+FootswitchBinding MidiFootswitchMap::getBinding(FootswitchAction action) const
+{
+    const auto index = static_cast<int>(action);
+    if (index < 0 || index >= numActions)
+        return {};
+
+    return unpack(bindings[static_cast<size_t>(index)].load());
+}
+
+void MidiFootswitchMap::beginLearn(FootswitchAction action)
+{
+    learnTarget.store(static_cast<int>(action));
+}
+
+void MidiFootswitchMap::cancelLearn()
+{
+    learnTarget.store(-1);
+}
+
+bool MidiFootswitchMap::isLearning() const
+{
+    return learnTarget.load() >= 0;
+}
+
+FootswitchAction MidiFootswitchMap::getLearnTarget() const
+{
+    const auto target = learnTarget.load();
+    return target >= 0 ? static_cast<FootswitchAction>(target) : FootswitchAction::Count;
+}
+
+bool MidiFootswitchMap::handleEvent(FootswitchBinding::Kind kind, int channel, int number, int value,
+                                    FootswitchAction& action)
+{
+    if (kind == FootswitchBinding::Kind::None)
+        return false;
+
+    const auto pressed = value >= 64 || (kind == FootswitchBinding::Kind::Note && value > 0);
+
+    auto target = learnTarget.load();
+    if (target >= 0 && target < numActions && pressed)
+    {
+        if (learnTarget.compare_exchange_strong(target, -1))
+        {
+            FootswitchBinding learned;
+            learned.kind = kind;
+            learned.channel = channel;
+            learned.number = number;
+            bindings[static_cast<size_t>(target)].store(pack(learned));
+            controllerDown[static_cast<size_t>(target)] = true;
+            return false;
+        }
+    }
+
+    for (int i = 0; i < numActions; ++i)
+    {
+        const auto binding = unpack(bindings[static_cast<size_t>(i)].load(std::memory_order_relaxed));
+        if (!matches(binding, kind, channel, number))
+            continue;
+
+        if (kind == FootswitchBinding::Kind::Controller)
+        {
+            auto& down = controllerDown[static_cast<size_t>(i)];
+            const auto wasDown = down;
+            down = pressed;
+            if (!pressed || wasDown)
+                return false;
+        }
+        else if (!pressed)
+        {
+            return false;
+        }
+
+        action = static_cast<FootswitchAction>(i);
+        return true;
+    }
+
+    return false;
+}
+
+const char* MidiFootswitchMap::getActionName(FootswitchAction action)
+{
+    switch (action)
+    {
+        case FootswitchAction::Record: return "Record";
+        case FootswitchAction::Play: return "Play";
+        case FootswitchAction::Overdub: return "Overdub";
+        case FootswitchAction::Clear: return "Clear";
+        case FootswitchAction::Reverse: return "Reverse";
+        case FootswitchAction::HalfSpeed: return "Half-speed";
+        case FootswitchAction::Count: break;
+    }
+
+    return "";
+}
+
+std::uint32_t MidiFootswitchMap::pack(FootswitchBinding binding)
+{
+    return (static_cast<std::uint32_t>(binding.kind) << 16)
+           | (static_cast<std::uint32_t>(binding.channel & 0xff) << 8)
+           | static_cast<std::uint32_t>(binding.number & 0xff);
+}
+
+FootswitchBinding MidiFootswitchMap::unpack(std::uint32_t packed)
+{
+    FootswitchBinding binding;
+    binding.kind = static_cast<FootswitchBinding::Kind>((packed >> 16) & 0xffu);
+    binding.channel = static_cast<int>((packed >> 8) & 0xffu);
+    binding.number = static_cast<int>(packed & 0xffu);
+    return binding;
+}
+
+bool MidiFootswitchMap::matches(FootswitchBinding binding, FootswitchBinding::Kind kind, int channel, int number)
+{
+    return binding.kind == kind
+           && binding.number == number
+           && (binding.channel == 0 || binding.channel == channel);
+}
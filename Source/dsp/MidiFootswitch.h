@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+enum class FootswitchAction
+{
+    Record,
+    Play,
+    Overdub,
+    Clear,
+    Reverse,
+    HalfSpeed,
+    Count
+};
+
+struct FootswitchBinding
+{
+    enum class Kind : std::uint8_t
+    {
+        None,
+        Note,
+        Controller
+    };
+
+    Kind kind = Kind::None;
+    int channel = 0; // 0 = omni, 1-16 otherwise
+    int number = 0;
+
+    bool operator==(const FootswitchBinding& other) const
+    {
+        return kind == other.kind && channel == other.channel && number == other.number;
+    }
+};
+
+// Maps MIDI notes/CCs to loop footswitch actions. Bindings and learn state are atomics so the
+// message thread can edit them while the audio thread resolves incoming events.
+class MidiFootswitchMap
+{
+public:
+    static constexpr int numActions = static_cast<int>(FootswitchAction::Count);
+    static constexpr int defaultFirstController = 80;
+
+    MidiFootswitchMap();
+
+    void resetToDefaults();
+    void setBinding(FootswitchAction action, FootswitchBinding binding);
+    FootswitchBinding getBinding(FootswitchAction action) const;
+
+    void beginLearn(FootswitchAction action);
+    void cancelLearn();
+    bool isLearning() const;
+    FootswitchAction getLearnTarget() const;
+
+    // Returns true and sets `action` when the event is a press on a bound footswitch.
+    // Notes press on note-on; controllers press when crossing from below 64 to 64 or above.
+    bool handleEvent(FootswitchBinding::Kind kind, int channel, int number, int value, FootswitchAction& action);
+
+    static const char* getActionName(FootswitchAction action);
+
+private:
+    static std::uint32_t pack(FootswitchBinding binding);
+    static FootswitchBinding unpack(std::uint32_t packed);
+    static bool matches(FootswitchBinding binding, FootswitchBinding::Kind kind, int channel, int number);
+
+    std::array<std::atomic<std::uint32_t>, numActions> bindings;
+    std::array<bool, numActions> controllerDown {};
+    std::atomic<int> learnTarget { -1 };
+};
@@ -0,0 +1,146 @@
+#include "MultiTap.h"
+
+#include "MemoryBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+void MultiTap::prepare(int maxBlockSize)
+{
+    gather.assign(static_cast<size_t>(std::max(1, maxBlockSize)), 0.0f);
+    channelGather.assign(static_cast<size_t>(std::max(1, maxBlockSize)), 0.0f);
+    reset();
+}
+
+void MultiTap::reset()
+{
+    currentGain.fill(0.0f);
+    currentSend.fill(0.0f);
+}
+
+void MultiTap::setNumTaps(int count)
+{
+    numTaps = std::clamp(count, 0, maxTaps);
+}
+
+void MultiTap::setTap(int index, const Tap& tap)
+{
+    if (index < 0 || index >= maxTaps)
+        return;
+
+    auto& target = taps[static_cast<size_t>(index)];
+    target.delaySamples = std::max(0.0f, tap.delaySamples);
+    target.gain = std::max(0.0f, tap.gain);
+    target.pan = std::clamp(tap.pan, -1.0f, 1.0f);
+    target.feedbackSend = std::max(0.0f, tap.feedbackSend);
+}
+
+const MultiTap::Tap& MultiTap::getTap(int index) const
+{
+    return taps[static_cast<size_t>(std::clamp(index, 0, maxTaps - 1))];
+}
+
+bool MultiTap::isActive() const
+{
+    for (int t = 0; t < numTaps; ++t)
+    {
+        if (isTapActive(t))
+            return true;
+    }
+
+    return false;
+}
+
+bool MultiTap::isTapActive(int index) const
+{
+    if (index < 0 || index >= numTaps)
+        return false;
+
+    const auto i = static_cast<size_t>(index);
+    return taps[i].gain > 0.0f || taps[i].feedbackSend > 0.0f || currentGain[i] > 0.0f || currentSend[i] > 0.0f;
+}
+
+void MultiTap::process(const MemoryBuffer& buffer,
+                       int writeIndex,
+                       float* const* output,
+                       float* const* send,
+                       int numChannels,
+                       int numSamples)
+{
+    numSamples = std::min(numSamples, static_cast<int>(gather.size()));
+    numNearTaps = 0;
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        std::fill(output[channel], output[channel] + numSamples, 0.0f);
+        std::fill(send[channel], send[channel] + numSamples, 0.0f);
+    }
+
+    if (numSamples <= 0 || numChannels <= 0)
+        return;
+
+    constexpr float kQuarterPi = 0.78539816339744830962f;
+    const auto sourceChannels = std::min(numChannels, buffer.getNumChannels());
+    const auto channelScale = 1.0f / static_cast<float>(std::max(1, sourceChannels));
+    const auto step = 1.0f / static_cast<float>(numSamples);
+
+    for (int t = 0; t < numTaps; ++t)
+    {
+        const auto index = static_cast<size_t>(t);
+        const auto& tap = taps[index];
+        const auto startGain = currentGain[index];
+        const auto startSend = currentSend[index];
+        currentGain[index] = tap.gain;
+        currentSend[index] = tap.feedbackSend;
+
+        if (startGain <= 0.0f && startSend <= 0.0f && tap.gain <= 0.0f && tap.feedbackSend <= 0.0f)
+            continue;
+
+        const auto angle = (tap.pan + 1.0f) * kQuarterPi;
+        const auto gainStep = (tap.gain - startGain) * step;
+        const auto sendStep = (tap.feedbackSend - startSend) * step;
+
+        if (std::floor(tap.delaySamples) < static_cast<float>(numSamples))
+        {
+            auto& near = nearTaps[static_cast<size_t>(numNearTaps++)];
+            near.wholeDelay = std::max(1, static_cast<int>(std::ceil(tap.delaySamples)));
+            near.fraction = static_cast<float>(near.wholeDelay) - std::max(1.0f, tap.delaySamples);
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                const auto panGain = numChannels == 1 ? 1.0f : (channel == 0 ? std::cos(angle) : std::sin(angle));
+                near.scale[static_cast<size_t>(channel)] = panGain * channelScale;
+            }
+            near.gain = startGain;
+            near.gainStep = gainStep;
+            near.send = startSend;
+            near.sendStep = sendStep;
+            continue;
+        }
+
+        const auto position = static_cast<double>(writeIndex) - static_cast<double>(tap.delaySamples);
+        buffer.readLinearBlock(0, position, gather.data(), numSamples);
+        for (int channel = 1; channel < sourceChannels; ++channel)
+        {
+            buffer.readLinearBlock(channel, position, channelGather.data(), numSamples);
+            for (int i = 0; i < numSamples; ++i)
+                gather[static_cast<size_t>(i)] += channelGather[static_cast<size_t>(i)];
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const auto panGain = numChannels == 1 ? 1.0f
+                                                  : (channel == 0 ? std::cos(angle) : std::sin(angle));
+            const auto scale = panGain * channelScale;
+            auto* out = output[channel];
+            auto* fb = send[channel];
+            const auto* src = gather.data();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto ramp = static_cast<float>(i + 1);
+                const auto value = src[i] * scale;
+                out[i] += value * (startGain + gainStep * ramp);
+                fb[i] += value * (startSend + sendStep * ramp);
+            }
+        }
+    }
+}
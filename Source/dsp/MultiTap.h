@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+class MemoryBuffer;
+
+// Extra read taps on the shared delay buffer. A tap reads consecutive positions for a whole block,
+// so each one is gathered as contiguous segments and mixed in a single pass; the buffer and its
+// write path stay shared with the main read head. A tap closer than the block would gather samples
+// the block has not written yet, so it is handed on as a NearTap for the delay kernel to read
+// sample by sample as it writes.
+class MultiTap
+{
+public:
+    static constexpr int maxTaps = 8;
+
+    struct Tap
+    {
+        float delaySamples = 0.0f;
+        float gain = 0.0f;
+        float pan = 0.0f;
+        float feedbackSend = 0.0f;
+    };
+
+    // Everything the delay kernel needs to render one near tap for the block. Sample i reads
+    // writeIndex + i - wholeDelay, blended towards the next sample by fraction; the output and send
+    // gains ramp as start + step * (i + 1), times scale for the output channel.
+    struct NearTap
+    {
+        int wholeDelay = 1;
+        float fraction = 0.0f;
+        std::array<float, 2> scale {};
+        float gain = 0.0f;
+        float gainStep = 0.0f;
+        float send = 0.0f;
+        float sendStep = 0.0f;
+    };
+
+    void prepare(int maxBlockSize);
+    void reset();
+
+    void setNumTaps(int count);
+    int getNumTaps() const { return numTaps; }
+    void setTap(int index, const Tap& tap);
+    const Tap& getTap(int index) const;
+
+    // True while any tap is audible or still ramping down.
+    bool isActive() const;
+    bool isTapActive(int index) const;
+
+    // Taps are mono sums of the buffer channels, panned equal-power across stereo outputs. Sample i
+    // reads writeIndex + i - delaySamples. Gain and send ramp linearly across the block; output and
+    // send are overwritten. Taps less than numSamples behind the write head (at least a sample) are
+    // left out of output and send and described by getNearTaps() until the next call instead.
+    void process(const MemoryBuffer& buffer,
+                 int writeIndex,
+                 float* const* output,
+                 float* const* send,
+                 int numChannels,
+                 int numSamples);
+
+    const NearTap* getNearTaps() const { return nearTaps.data(); }
+    int getNumNearTaps() const { return numNearTaps; }
+
+private:
+    std::array<Tap, maxTaps> taps {};
+    std::array<float, maxTaps> currentGain {};
+    std::array<float, maxTaps> currentSend {};
+    std::vector<float> gather;
+    std::vector<float> channelGather;
+    std::array<NearTap, maxTaps> nearTaps {};
+    int numTaps = 0;
+    int numNearTaps = 0;
+};
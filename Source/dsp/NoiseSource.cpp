@@ -0,0 +1,58 @@
+#include "NoiseSource.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr std::uint32_t kChannelStride = 0x9e3779b9u;
+    constexpr float kScale = 1.0f / 16777215.0f;
+
+    std::uint32_t channelKey(std::uint32_t seed, int channel)
+    {
+        return seed ^ (static_cast<std::uint32_t>(channel + 1) * kChannelStride);
+    }
+}
+
+void NoiseSource::prepare(int numChannels)
+{
+    counters.assign(static_cast<size_t>(std::max(1, numChannels)), 0u);
+}
+
+void NoiseSource::reset(std::uint32_t newSeed)
+{
+    seed = newSeed;
+    std::fill(counters.begin(), counters.end(), 0u);
+}
+
+void NoiseSource::fill(int channel, float* dest, int numSamples)
+{
+    if (dest == nullptr || numSamples <= 0 || channel < 0 || channel >= static_cast<int>(counters.size()))
+        return;
+
+    const auto key = channelKey(seed, channel);
+    const auto base = counters[static_cast<size_t>(channel)];
+
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] = valueAt(key, base + static_cast<std::uint32_t>(i));
+
+    counters[static_cast<size_t>(channel)] = base + static_cast<std::uint32_t>(numSamples);
+}
+
+float NoiseSource::valueAt(std::uint32_t key, std::uint32_t counter)
+{
+    // The key is hashed on its own and mixed back in after the counter round, so streams with
+    // different keys share no structure: neither shifted nor permuted copies of one another.
+    const auto bits = hash(hash(counter ^ hash(key)) + key);
+    return static_cast<float>(bits >> 8) * kScale;
+}
+
+std::uint32_t NoiseSource::hash(std::uint32_t x)
+{
+    // lowbias32 integer finalizer
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
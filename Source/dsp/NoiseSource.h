@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Counter-based noise: every sample is a hash of (channel key, counter), so a block fills
+// without a loop-carried dependency and each channel gets an independent stream.
+class NoiseSource
+{
+public:
+    static constexpr std::uint32_t defaultSeed = 0x1234567u;
+
+    void prepare(int numChannels);
+    void reset(std::uint32_t seed = defaultSeed);
+
+    void fill(int channel, float* dest, int numSamples);
+    static float valueAt(std::uint32_t key, std::uint32_t counter);
+
+private:
+    static std::uint32_t hash(std::uint32_t x);
+
+    std::uint32_t seed = defaultSeed;
+    std::vector<std::uint32_t> counters;
+};
@@ -1,5 +1,7 @@
 #include "Overdub.h"
 
+#include "FeedbackModel.h"
+
 #include <algorithm>
 
 float Overdub::computeRetain(float erodeAmount)
@@ -10,6 +12,11 @@ float Overdub::computeRetain(float erodeAmount)
     return retainMin + (retainMax - retainMin) * (1.0f - erodeAmount);
 }
 
+Overdub::Gains Overdub::makeGains(float overdubLevel, float feedback, float erodeAmount)
+{
+    return { overdubLevel, feedback, computeRetain(erodeAmount) };
+}
+
 float Overdub::apply(float existingSample, float inputSample, float readSample, float overdubLevel,
                      float feedback, float erodeAmount)
 {
@@ -17,3 +24,69 @@ float Overdub::apply(float existingSample, float inputSample, float readSample,
     const auto writeInput = inputSample * overdubLevel + readSample * feedback;
     return existingSample * retain + writeInput;
 }
+
+namespace
+{
+    float loadCell(const float& cell, const SampleCodec&) { return cell; }
+    float loadCell(const std::int16_t& cell, const SampleCodec& codec) { return codec.unpack(cell); }
+    void storeCell(float& cell, float value, const SampleCodec&) { cell = value; }
+    void storeCell(std::int16_t& cell, float value, const SampleCodec& codec) { cell = codec.pack(value); }
+
+    template <bool WithNoise, typename Sample>
+    void processOverdubBlock(const Overdub::Block& block, Sample* const* loop, FeedbackModel& degrade,
+                             const Overdub::Gains& from, const Overdub::Gains& to)
+    {
+        const auto step = 1.0f / static_cast<float>(block.numSamples);
+        const auto levelStep = (to.overdubLevel - from.overdubLevel) * step;
+        const auto feedbackStep = (to.feedback - from.feedback) * step;
+        const auto retainStep = (to.retain - from.retain) * step;
+
+        // Frames stay outermost; the degrade chain takes each frame at once, one channel per lane.
+        const auto numChannels = std::min(block.numChannels, FeedbackModel::maxChannels);
+        for (int i = 0; i < block.numSamples; ++i)
+        {
+            const auto ramp = static_cast<float>(i + 1);
+            const auto level = from.overdubLevel + levelStep * ramp;
+            const auto feedback = from.feedback + feedbackStep * ramp;
+            const auto retain = from.retain + retainStep * ramp;
+            const auto index = block.indices[i];
+
+            FeedbackModel::Frame frame {};
+            FeedbackModel::Frame random {};
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                frame[static_cast<size_t>(channel)] = loadCell(loop[channel][index], block.codec) * retain
+                                                      + block.input[channel][i] * level
+                                                      + block.read[channel][i] * feedback;
+                if constexpr (WithNoise)
+                    random[static_cast<size_t>(channel)] = block.noise[channel][i];
+            }
+
+            degrade.processFrameFixed<WithNoise>(frame, random, numChannels, 1.0f);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                storeCell(loop[channel][index], frame[static_cast<size_t>(channel)], block.codec);
+        }
+    }
+}
+
+void Overdub::processBlock(const Block& block, FeedbackModel& degrade, const Gains& from, const Gains& to)
+{
+    if (block.numSamples <= 0)
+        return;
+
+    if (block.packedLoop != nullptr)
+    {
+        if (degrade.hasNoise())
+            processOverdubBlock<true>(block, block.packedLoop, degrade, from, to);
+        else
+            processOverdubBlock<false>(block, block.packedLoop, degrade, from, to);
+    }
+    else
+    {
+        if (degrade.hasNoise())
+            processOverdubBlock<true>(block, block.loop, degrade, from, to);
+        else
+            processOverdubBlock<false>(block, block.loop, degrade, from, to);
+    }
+}
@@ -1,9 +1,41 @@
 #pragma once
 
+#include "SampleCodec.h"
+
+#include <cstdint>
+
+class FeedbackModel;
+
 class Overdub
 {
 public:
+    struct Gains
+    {
+        float overdubLevel = 0.0f;
+        float feedback = 0.0f;
+        float retain = 1.0f;
+    };
+
+    // One chunk of overdub: loop[c][indices[i]] is read, blended with input and the played-back
+    // signal, degraded and written back in a single pass. Gains ramp linearly from `from` to `to`;
+    // the degrade chain must already have its parameters set for the block. Integer-format buffers
+    // pass packedLoop and codec instead of loop.
+    struct Block
+    {
+        float* const* loop = nullptr;
+        const float* const* input = nullptr;
+        const float* const* read = nullptr;
+        const float* const* noise = nullptr;
+        const int* indices = nullptr;
+        int numChannels = 0;
+        int numSamples = 0;
+        std::int16_t* const* packedLoop = nullptr;
+        SampleCodec codec {};
+    };
+
     static float computeRetain(float erodeAmount);
+    static Gains makeGains(float overdubLevel, float feedback, float erodeAmount);
     static float apply(float existingSample, float inputSample, float readSample, float overdubLevel,
                        float feedback, float erodeAmount);
+    static void processBlock(const Block& block, FeedbackModel& degrade, const Gains& from, const Gains& to);
 };
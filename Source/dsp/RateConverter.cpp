@@ -0,0 +1,109 @@
+#include "RateConverter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double kKaiserBeta = 9.0;
+    // Fraction of the lower Nyquist frequency kept in the passband.
+    constexpr double kPassband = 0.95;
+    // Kernel half-width at full bandwidth, in input samples.
+    constexpr int kBaseHalfTaps = 16;
+
+    double besselI0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+        const auto halfX = x * 0.5;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+        }
+        return sum;
+    }
+}
+
+void RateConverter::prepare(double newRatio)
+{
+    if (newRatio == ratio && !bank.empty())
+        return;
+
+    ratio = newRatio;
+    const auto cutoff = std::min(1.0, ratio) * kPassband;
+    const auto halfTaps = std::min(maxTaps / 2, static_cast<int>(std::ceil(kBaseHalfTaps / cutoff)));
+    numTaps = halfTaps * 2;
+    bank.assign(static_cast<size_t>((numPhases + 1) * numTaps), 0.0f);
+
+    const auto windowNorm = besselI0(kKaiserBeta);
+    constexpr double kPi = 3.14159265358979323846;
+    std::vector<double> coefficients(static_cast<size_t>(numTaps));
+
+    for (int phase = 0; phase <= numPhases; ++phase)
+    {
+        const auto fraction = static_cast<double>(phase) / numPhases;
+        double sum = 0.0;
+
+        for (int k = 0; k < numTaps; ++k)
+        {
+            const auto x = static_cast<double>(k - (halfTaps - 1)) - fraction;
+            const auto arg = kPi * cutoff * x;
+            const auto sinc = std::abs(x) < 1.0e-12 ? 1.0 : std::sin(arg) / arg;
+            const auto position = x / static_cast<double>(halfTaps);
+            const auto window = std::abs(position) >= 1.0
+                                    ? 0.0
+                                    : besselI0(kKaiserBeta * std::sqrt(1.0 - position * position)) / windowNorm;
+            coefficients[static_cast<size_t>(k)] = cutoff * sinc * window;
+            sum += coefficients[static_cast<size_t>(k)];
+        }
+
+        auto* taps = bank.data() + static_cast<size_t>(phase * numTaps);
+        for (int k = 0; k < numTaps; ++k)
+            taps[k] = static_cast<float>(coefficients[static_cast<size_t>(k)] / sum);
+    }
+}
+
+void RateConverter::process(const float* cycle, int length, float* dest, int destLength) const
+{
+    process(cycle, length, dest, destLength, 0, destLength);
+}
+
+void RateConverter::process(const float* cycle, int length, float* dest, int destLength, int destStart,
+                            int count) const
+{
+    if (length <= 0 || destLength <= 0 || bank.empty())
+    {
+        std::fill(dest, dest + std::max(0, count), 0.0f);
+        return;
+    }
+
+    const auto halfTaps = numTaps / 2;
+    const auto step = static_cast<double>(length) / static_cast<double>(destLength);
+
+    for (int i = destStart; i < destStart + count; ++i)
+    {
+        const auto position = static_cast<double>(i) * step;
+        const auto base = static_cast<int>(position);
+        const auto phasePosition = (position - base) * numPhases;
+        const auto phase = std::min(numPhases - 1, static_cast<int>(phasePosition));
+        const auto blend = static_cast<float>(phasePosition - phase);
+        const auto* tapsA = bank.data() + static_cast<size_t>(phase * numTaps);
+        const auto* tapsB = tapsA + numTaps;
+
+        auto index = (base - (halfTaps - 1)) % length;
+        if (index < 0)
+            index += length;
+
+        float sum = 0.0f;
+        for (int k = 0; k < numTaps; ++k)
+        {
+            const auto tap = tapsA[k] + (tapsB[k] - tapsA[k]) * blend;
+            sum += cycle[index] * tap;
+            if (++index == length)
+                index = 0;
+        }
+
+        dest[i - destStart] = sum;
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+// Offline sample-rate conversion of a cyclic region with a polyphase Kaiser-windowed sinc. The
+// passband sits just below the lower of the two Nyquist frequencies, so downsampling does not
+// alias; the kernel widens as the cutoff drops. Coefficients are interpolated between adjacent
+// phases. Allocates; for worker threads only.
+class RateConverter
+{
+public:
+    static constexpr int numPhases = 512;
+    static constexpr int maxTaps = 128;
+
+    // `ratio` is output rate over input rate.
+    void prepare(double ratio);
+    double getRatio() const { return ratio; }
+    int getNumTaps() const { return numTaps; }
+
+    // Renders destLength samples covering exactly one cycle of the `length` input samples, reading
+    // across the cycle end from its start, so converted loops stay seamless.
+    void process(const float* cycle, int length, float* dest, int destLength) const;
+    // The same conversion, rendering only output samples [destStart, destStart + count) into dest,
+    // so a long cycle can be converted a piece at a time.
+    void process(const float* cycle, int length, float* dest, int destLength, int destStart, int count) const;
+
+private:
+    double ratio = 0.0;
+    int numTaps = 0;
+    // numPhases + 1 rows, so the last phase can interpolate towards the next integer step.
+    std::vector<float> bank;
+};
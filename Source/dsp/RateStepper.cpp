@@ -2,20 +2,69 @@
 
 #include <cmath>
 
+namespace
+{
+    constexpr double kOne = 4294967296.0;
+    constexpr std::uint64_t kFractionMask = 0xffffffffu;
+
+    std::int64_t toFixed(double value)
+    {
+        return static_cast<std::int64_t>(std::llround(value * kOne));
+    }
+}
+
 void RateStepper::reset(double newPosition)
 {
-    position = newPosition;
+    position = toFixed(newPosition);
+    wrap();
+}
+
+void RateStepper::setLength(int lengthSamples)
+{
+    length = lengthSamples > 0 ? lengthSamples : 0;
+    lengthFixed = static_cast<std::int64_t>(length) << fractionBits;
+    wrap();
 }
 
 void RateStepper::setRate(double newRate)
 {
-    rate = newRate;
+    increment = toFixed(newRate);
+    targetIncrement = increment;
+    incrementStep = 0;
+    rampRemaining = 0;
+}
+
+void RateStepper::setRateSmoothed(double targetRate, int rampSamples)
+{
+    const auto target = toFixed(targetRate);
+    if (rampSamples <= 0 || target == increment)
+    {
+        setRate(targetRate);
+        return;
+    }
+
+    if (target == targetIncrement && rampRemaining > 0)
+        return;
+
+    targetIncrement = target;
+    incrementStep = (targetIncrement - increment) / rampSamples;
+    rampRemaining = rampSamples;
+}
+
+double RateStepper::getRate() const
+{
+    return static_cast<double>(increment) / kOne;
+}
+
+double RateStepper::getTargetRate() const
+{
+    return static_cast<double>(targetIncrement) / kOne;
 }
 
 double RateStepper::advance()
 {
-    position += rate;
-    return position;
+    step();
+    return getPosition();
 }
 
 int RateStepper::getIndex(int bufferSize) const
@@ -23,9 +72,67 @@ int RateStepper::getIndex(int bufferSize) const
     if (bufferSize <= 0)
         return 0;
 
-    auto wrapped = std::fmod(position, static_cast<double>(bufferSize));
-    if (wrapped < 0.0)
-        wrapped += static_cast<double>(bufferSize);
+    // Arithmetic shift floors negative positions.
+    const auto whole = position >> fractionBits;
+    if (bufferSize == length)
+        return static_cast<int>(whole);
+
+    auto wrapped = whole % bufferSize;
+    if (wrapped < 0)
+        wrapped += bufferSize;
 
     return static_cast<int>(wrapped);
 }
+
+float RateStepper::getFraction() const
+{
+    return static_cast<float>(static_cast<std::uint64_t>(position) & kFractionMask) * (1.0f / 4294967296.0f);
+}
+
+double RateStepper::getPosition() const
+{
+    return static_cast<double>(position) / kOne;
+}
+
+void RateStepper::fillBlock(int* indices, float* fractions, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        indices[i] = getIndex(length);
+        if (fractions != nullptr)
+            fractions[i] = getFraction();
+        step();
+    }
+}
+
+void RateStepper::step()
+{
+    position += increment;
+    wrap();
+
+    if (rampRemaining > 0)
+    {
+        if (--rampRemaining == 0)
+            increment = targetIncrement;
+        else
+            increment += incrementStep;
+    }
+}
+
+void RateStepper::wrap()
+{
+    if (lengthFixed <= 0)
+        return;
+
+    if (position >= lengthFixed)
+        position -= lengthFixed;
+    else if (position < 0)
+        position += lengthFixed;
+
+    if (position < 0 || position >= lengthFixed)
+    {
+        position %= lengthFixed;
+        if (position < 0)
+            position += lengthFixed;
+    }
+}
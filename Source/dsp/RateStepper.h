@@ -1,17 +1,41 @@
 #pragma once
 
+#include <cstdint>
+
+// Loop read position as 32.32 fixed point. With a wrap length set, the position stays in
+// [0, length) using integer compares only; without one it runs free and getIndex() wraps.
 class RateStepper
 {
 public:
+    static constexpr int fractionBits = 32;
+
     void reset(double position = 0.0);
+    void setLength(int lengthSamples);
+    int getLength() const { return length; }
+
     void setRate(double newRate);
-    double getRate() const { return rate; }
+    void setRateSmoothed(double targetRate, int rampSamples);
+    double getRate() const;
+    double getTargetRate() const;
 
     double advance();
     int getIndex(int bufferSize) const;
-    double getPosition() const { return position; }
+    float getFraction() const;
+    double getPosition() const;
+
+    // Writes the index/fraction of each of the next numSamples positions, then advances past them.
+    // Requires a wrap length; fractions may be null.
+    void fillBlock(int* indices, float* fractions, int numSamples);
 
 private:
-    double position = 0.0;
-    double rate = 1.0;
+    void step();
+    void wrap();
+
+    std::int64_t position = 0;
+    std::int64_t increment = std::int64_t { 1 } << fractionBits;
+    std::int64_t targetIncrement = std::int64_t { 1 } << fractionBits;
+    std::int64_t incrementStep = 0;
+    int rampRemaining = 0;
+    int length = 0;
+    std::int64_t lengthFixed = 0;
 };
@@ -0,0 +1,37 @@
+#include "ReadHeadCrossfader.h"
+
+#include <cmath>
+
+void ReadHeadCrossfader::begin(const RateStepper& previous, int newPreviousOffset, int fadeSamples)
+{
+    previousHead = previous;
+    previousOffset = newPreviousOffset;
+    length = fadeSamples > 0 ? fadeSamples : 0;
+    position = 0;
+}
+
+void ReadHeadCrossfader::stop()
+{
+    length = 0;
+    position = 0;
+}
+
+void ReadHeadCrossfader::fillGains(float* gains, int numSamples)
+{
+    constexpr float kHalfPi = 1.57079632679489661923f;
+    const auto step = length > 0 ? 1.0f / static_cast<float>(length) : 1.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (position < length)
+        {
+            ++position;
+            const auto s = std::sin(kHalfPi * static_cast<float>(position) * step);
+            gains[i] = s * s;
+        }
+        else
+        {
+            gains[i] = 1.0f;
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "RateStepper.h"
+
+// Keeps the previous read head running after a pointer jump and supplies the fade-in gain of
+// the new head. The previous head is a RateStepper over [offset, offset + length) of the buffer.
+class ReadHeadCrossfader
+{
+public:
+    void begin(const RateStepper& previous, int previousOffset, int fadeSamples);
+    void stop();
+    bool isActive() const { return position < length; }
+
+    RateStepper& getPreviousHead() { return previousHead; }
+    int getPreviousOffset() const { return previousOffset; }
+
+    // Gain of the new head for the next numSamples (sin^2 ramp, 1 once the fade is done).
+    void fillGains(float* gains, int numSamples);
+
+private:
+    RateStepper previousHead;
+    int previousOffset = 0;
+    int length = 0;
+    int position = 0;
+};
@@ -0,0 +1,21 @@
+#include "SampleCodec.h"
+
+SampleCodec SampleCodec::forFormat(SampleFormat format)
+{
+    if (format == SampleFormat::Int12)
+        return { 2047.0f, 16, 1.0f / (2047.0f * 16.0f) };
+
+    return {};
+}
+
+void SampleCodec::packBlock(const float* source, std::int16_t* dest, int numSamples) const
+{
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] = pack(source[i]);
+}
+
+void SampleCodec::unpackBlock(const std::int16_t* source, float* dest, int numSamples) const
+{
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] = unpack(source[i]);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+// How the delay memory holds samples. The integer formats store full scale (±1) in 16-bit words,
+// halving the footprint of Float32; Int12 keeps only the top 12 bits of each word. Values beyond
+// full scale clip, as a converter would.
+enum class SampleFormat
+{
+    Float32,
+    Int16,
+    Int12
+};
+
+// Conversion between float samples and integer storage words for one format.
+struct SampleCodec
+{
+    float packScale = 32767.0f;
+    int packStep = 1;
+    float unpackScale = 1.0f / 32767.0f;
+
+    static SampleCodec forFormat(SampleFormat format);
+
+    std::int16_t pack(float value) const
+    {
+        const auto scaled = std::min(1.0f, std::max(-1.0f, value)) * packScale;
+        const auto word = static_cast<int>(scaled + (scaled < 0.0f ? -0.5f : 0.5f));
+        return static_cast<std::int16_t>(word * packStep);
+    }
+
+    float unpack(std::int16_t word) const { return static_cast<float>(word) * unpackScale; }
+
+    // Straight loops without branches in the body, so they vectorise.
+    void packBlock(const float* source, std::int16_t* dest, int numSamples) const;
+    void unpackBlock(const std::int16_t* source, float* dest, int numSamples) const;
+};
@@ -0,0 +1,101 @@
+#include "SignalWatchdog.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr std::uint32_t kExponentMask = 0x7f800000u;
+    constexpr std::uint32_t kMantissaMask = 0x007fffffu;
+}
+
+SignalWatchdog::ScanResult SignalWatchdog::scan(const float* data, int numSamples)
+{
+    ScanResult result;
+    if (data == nullptr || numSamples <= 0)
+        return result;
+
+    // Branch-free classification on the raw bits so the loop vectorizes.
+    int nans = 0;
+    int infs = 0;
+    int denormals = 0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, data + i, sizeof(bits));
+        const auto exponent = bits & kExponentMask;
+        const auto mantissa = bits & kMantissaMask;
+        const auto maxExponent = static_cast<int>(exponent == kExponentMask);
+        const auto hasMantissa = static_cast<int>(mantissa != 0u);
+        nans += maxExponent & hasMantissa;
+        infs += maxExponent & (hasMantissa ^ 1);
+        denormals += static_cast<int>(exponent == 0u) & hasMantissa;
+    }
+
+    result.nanCount = nans;
+    result.infCount = infs;
+    result.denormalCount = denormals;
+    return result;
+}
+
+SignalWatchdog::ScanResult SignalWatchdog::scanCircular(const float* data, int size, int start, int length)
+{
+    if (data == nullptr || size <= 0 || length <= 0)
+        return {};
+
+    length = std::min(length, size);
+    start %= size;
+    if (start < 0)
+        start += size;
+
+    const auto first = std::min(length, size - start);
+    auto result = scan(data + start, first);
+    if (first < length)
+        result += scan(data, length - first);
+
+    return result;
+}
+
+int SignalWatchdog::sanitize(float* data, int numSamples)
+{
+    if (data == nullptr)
+        return 0;
+
+    int replaced = 0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, data + i, sizeof(bits));
+        const auto exponent = bits & kExponentMask;
+        if (exponent == kExponentMask || (exponent == 0u && (bits & kMantissaMask) != 0u))
+        {
+            data[i] = 0.0f;
+            ++replaced;
+        }
+    }
+
+    return replaced;
+}
+
+void SignalWatchdog::report(const ScanResult& result)
+{
+    if (!result.hasEvents())
+        return;
+
+    nanCount.fetch_add(static_cast<std::uint64_t>(result.nanCount), std::memory_order_relaxed);
+    infCount.fetch_add(static_cast<std::uint64_t>(result.infCount), std::memory_order_relaxed);
+    denormalCount.fetch_add(static_cast<std::uint64_t>(result.denormalCount), std::memory_order_relaxed);
+}
+
+void SignalWatchdog::reportRecovery()
+{
+    recoveryCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SignalWatchdog::resetCounters()
+{
+    nanCount.store(0, std::memory_order_relaxed);
+    infCount.store(0, std::memory_order_relaxed);
+    denormalCount.store(0, std::memory_order_relaxed);
+    recoveryCount.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+class SignalWatchdog
+{
+public:
+    struct ScanResult
+    {
+        int nanCount = 0;
+        int infCount = 0;
+        int denormalCount = 0;
+
+        bool hasNonFinite() const { return nanCount > 0 || infCount > 0; }
+        bool hasEvents() const { return hasNonFinite() || denormalCount > 0; }
+
+        ScanResult& operator+=(const ScanResult& other)
+        {
+            nanCount += other.nanCount;
+            infCount += other.infCount;
+            denormalCount += other.denormalCount;
+            return *this;
+        }
+    };
+
+    static ScanResult scan(const float* data, int numSamples);
+    static ScanResult scanCircular(const float* data, int size, int start, int length);
+    static int sanitize(float* data, int numSamples);
+
+    void report(const ScanResult& result);
+    void reportRecovery();
+    void resetCounters();
+
+    void setAutoRecover(bool enabled) { autoRecover.store(enabled); }
+    bool getAutoRecover() const { return autoRecover.load(); }
+
+    std::uint64_t getNanCount() const { return nanCount.load(std::memory_order_relaxed); }
+    std::uint64_t getInfCount() const { return infCount.load(std::memory_order_relaxed); }
+    std::uint64_t getDenormalCount() const { return denormalCount.load(std::memory_order_relaxed); }
+    std::uint64_t getRecoveryCount() const { return recoveryCount.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> nanCount { 0 };
+    std::atomic<std::uint64_t> infCount { 0 };
+    std::atomic<std::uint64_t> denormalCount { 0 };
+    std::atomic<std::uint64_t> recoveryCount { 0 };
+    std::atomic<bool> autoRecover { true };
+};
@@ -6,38 +6,187 @@
 void Smoother::reset(double newSampleRate, float initialValue, float newTimeMs)
 {
     sampleRate = (newSampleRate > 0.0) ? newSampleRate : 44100.0;
-    current = initialValue;
     target = initialValue;
+    offset = 0.0f;
+    remaining = 0;
     timeMs = std::max(0.0f, newTimeMs);
-    updateCoefficient();
+    updateTiming();
 }
 
 void Smoother::setTimeMs(float newTimeMs)
 {
-    timeMs = std::max(0.0f, newTimeMs);
-    updateCoefficient();
+    newTimeMs = std::max(0.0f, newTimeMs);
+    if (newTimeMs == timeMs)
+        return;
+
+    timeMs = newTimeMs;
+    updateTiming();
+    restart();
+}
+
+void Smoother::setShape(Shape newShape)
+{
+    if (newShape == shape)
+        return;
+
+    shape = newShape;
+    restart();
+}
+
+void Smoother::setStepMs(float newStepMs)
+{
+    newStepMs = std::max(0.0f, newStepMs);
+    if (newStepMs == stepMs)
+        return;
+
+    stepMs = newStepMs;
+    updateTiming();
+    restart();
 }
 
 void Smoother::setTarget(float targetValue)
 {
+    if (targetValue == target)
+        return;
+
+    offset = getCurrent() - targetValue;
     target = targetValue;
+    restart();
 }
 
 float Smoother::process()
 {
-    current += (target - current) * coefficient;
-    return current;
+    // One-sample block, so both forms produce the same values however the arithmetic is compiled.
+    auto value = target;
+    process(&value, 1);
+    return value;
 }
 
-void Smoother::updateCoefficient()
+void Smoother::process(float* destination, int numSamples)
 {
+    auto written = 0;
+    switch (shape)
+    {
+        case Shape::Exponential:
+        {
+            written = std::min(numSamples, remaining);
+            auto value = offset;
+            for (int i = 0; i < written; ++i)
+            {
+                value *= retain;
+                destination[i] = target + value;
+            }
+
+            remaining -= written;
+            offset = (remaining == 0) ? 0.0f : value;
+            if (remaining == 0 && written > 0)
+                destination[written - 1] = target;
+            break;
+        }
+
+        case Shape::Linear:
+        {
+            // offset(r) = slope * r for r samples still to go.
+            written = std::min(numSamples, remaining);
+            const auto last = remaining - 1;
+            for (int i = 0; i < written; ++i)
+                destination[i] = target + slope * static_cast<float>(last - i);
+
+            remaining -= written;
+            offset = slope * static_cast<float>(remaining);
+            break;
+        }
+
+        case Shape::Stepped:
+        {
+            // Hold until the remaining count reaches a multiple of the step, then take the ramp's
+            // value there.
+            while (written < numSamples && remaining > 0)
+            {
+                const auto hold = std::min(numSamples - written, (remaining - 1) % stepSamples);
+                std::fill(destination + written, destination + written + hold, target + offset);
+                written += hold;
+                remaining -= hold;
+
+                if (written < numSamples)
+                {
+                    --remaining;
+                    offset = slope * static_cast<float>(remaining);
+                    destination[written++] = target + offset;
+                }
+            }
+            break;
+        }
+    }
+
+    std::fill(destination + written, destination + numSamples, target);
+}
+
+void Smoother::updateTiming()
+{
+    const auto toSamples = [this](float ms)
+    {
+        return std::max(1, static_cast<int>(std::lround(static_cast<double>(ms) * 0.001 * sampleRate)));
+    };
+
+    rampSamples = toSamples(timeMs);
+    stepSamples = toSamples(stepMs);
+
     if (timeMs <= 0.0f)
     {
-        coefficient = 1.0f;
+        retain = 0.0f;
         return;
     }
 
     const auto timeSeconds = timeMs * 0.001f;
     const auto samples = static_cast<float>(std::max(1.0, timeSeconds * sampleRate));
-    coefficient = 1.0f - std::exp(-1.0f / samples);
+    retain = std::exp(-1.0f / samples);
+}
+
+void Smoother::restart()
+{
+    if (!std::isfinite(offset))
+        offset = 0.0f;
+
+    if (offset == 0.0f)
+    {
+        remaining = 0;
+        return;
+    }
+
+    switch (shape)
+    {
+        case Shape::Exponential:
+        {
+            // Closed form: the offset after n samples is offset * retain^n, so the ramp length to
+            // within the tolerance is known now and the block loop needs no per-sample check.
+            const auto tolerance = 1.0e-5f * std::max(1.0f, std::abs(target));
+            if (std::abs(offset) <= tolerance)
+            {
+                offset = 0.0f;
+                remaining = 0;
+            }
+            else if (retain <= 0.0f)
+            {
+                remaining = 1;
+            }
+            else
+            {
+                const auto samples = std::ceil(std::log(tolerance / std::abs(offset)) / std::log(retain));
+                remaining = std::max(1, static_cast<int>(samples));
+            }
+            break;
+        }
+
+        case Shape::Linear:
+            remaining = rampSamples;
+            slope = offset / static_cast<float>(remaining);
+            break;
+
+        case Shape::Stepped:
+            // Whole steps only, so the last one lands on the target.
+            remaining = (rampSamples + stepSamples - 1) / stepSamples * stepSamples;
+            slope = offset / static_cast<float>(remaining);
+            break;
+    }
 }
@@ -1,20 +1,51 @@
 #pragma once
 
+// Moves a value towards a target over timeMs. Every shape knows up front how many samples it has
+// left, so a block is written as a closed-form ramp segment followed by a constant run, and a
+// settled smoother costs no more than a fill.
 class Smoother
 {
 public:
+    enum class Shape
+    {
+        Exponential, // one-pole, timeMs is the time constant
+        Linear,      // straight line, reaches the target after timeMs
+        Stepped      // the linear ramp sampled every stepMs and held in between (zipper)
+    };
+
+    // Jumps to initialValue. The shape and step time are kept.
     void reset(double sampleRate, float initialValue, float timeMs);
+
+    // Changing the time, shape or step restarts the ramp from the current value; setting what is
+    // already set does nothing, so these can be called every block.
     void setTimeMs(float timeMs);
+    void setShape(Shape shape);
+    void setStepMs(float stepMs);
     void setTarget(float targetValue);
+
     float process();
-    float getCurrent() const { return current; }
+    void process(float* destination, int numSamples);
+
+    float getCurrent() const { return target + offset; }
+    float getTarget() const { return target; }
+
+    // True once the value sits exactly on the target; from then on every sample is the target.
+    bool isSettled() const { return remaining == 0; }
 
 private:
-    void updateCoefficient();
+    void updateTiming();
+    void restart();
 
     double sampleRate = 44100.0;
     float timeMs = 10.0f;
-    float current = 0.0f;
+    float stepMs = 1.0f;
+    Shape shape = Shape::Exponential;
+
     float target = 0.0f;
-    float coefficient = 1.0f;
+    float offset = 0.0f;      // current value minus target
+    int remaining = 0;        // samples until the value lands on the target
+    float retain = 0.0f;      // exponential: share of the offset kept per sample
+    float slope = 0.0f;       // linear and stepped: offset per remaining sample
+    int rampSamples = 1;
+    int stepSamples = 1;
 };
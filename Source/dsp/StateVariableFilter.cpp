@@ -0,0 +1,85 @@
+#include "StateVariableFilter.h"
+
+#include <algorithm>
+#include <cmath>
+
+void StateVariableFilter::prepare(double newSampleRate)
+{
+    sampleRate = (newSampleRate > 0.0) ? newSampleRate : 44100.0;
+    primed = false;
+    reset();
+}
+
+void StateVariableFilter::reset()
+{
+    ic1 = {};
+    ic2 = {};
+}
+
+void StateVariableFilter::setTarget(float cutoffHz, float newResonance, Mode newMode)
+{
+    targetCutoff = std::clamp(cutoffHz, 10.0f, static_cast<float>(sampleRate * 0.45));
+    targetResonance = std::clamp(newResonance, 0.0f, 1.0f);
+    mode = newMode;
+}
+
+void StateVariableFilter::updateCoefficients(int numSamples)
+{
+    if (!primed || numSamples <= 0)
+    {
+        cutoff = targetCutoff;
+        resonance = targetResonance;
+        primed = true;
+    }
+    else if (!isSettled())
+    {
+        // One-pole glide per block: the cutoff moves in octaves, the resonance linearly.
+        const auto decay = static_cast<float>(std::exp(-static_cast<double>(numSamples) / (0.01 * sampleRate)));
+        cutoff = targetCutoff * std::pow(cutoff / targetCutoff, decay);
+        resonance = targetResonance + (resonance - targetResonance) * decay;
+
+        if (std::abs(cutoff - targetCutoff) <= targetCutoff * 1.0e-4f)
+            cutoff = targetCutoff;
+        if (std::abs(resonance - targetResonance) <= 1.0e-4f)
+            resonance = targetResonance;
+    }
+
+    constexpr double kPi = 3.14159265358979323846;
+    const auto g = static_cast<float>(std::tan(kPi * static_cast<double>(cutoff) / sampleRate));
+    const auto k = 1.41421356f * std::pow(14.0f, -resonance);
+    const auto d = 1.0f / (1.0f + g * (g + k));
+    a1 = FloatLanes::expand(d);
+    a2 = FloatLanes::expand(g * d);
+    a3 = FloatLanes::expand(g * g * d);
+
+    // Output mix of input, bandpass and lowpass taps.
+    auto mix = [this](float input, float band, float low)
+    {
+        m0 = FloatLanes::expand(input);
+        m1 = FloatLanes::expand(band);
+        m2 = FloatLanes::expand(low);
+    };
+
+    switch (mode)
+    {
+        case Mode::Lowpass: mix(0.0f, 0.0f, 1.0f); break;
+        case Mode::Bandpass: mix(0.0f, k, 0.0f); break;
+        case Mode::Highpass: mix(1.0f, -k, -1.0f); break;
+    }
+}
+
+float StateVariableFilter::processSample(int lane, float input)
+{
+    const auto index = static_cast<size_t>(lane);
+    Frame frame {};
+    frame[index] = input;
+
+    auto state1 = ic1.toArray();
+    auto state2 = ic2.toArray();
+    const auto output = process(FloatLanes::fromArray(frame)).toArray();
+    state1[index] = ic1.toArray()[index];
+    state2[index] = ic2.toArray()[index];
+    ic1 = FloatLanes::fromArray(state1);
+    ic2 = FloatLanes::fromArray(state2);
+    return output[index];
+}
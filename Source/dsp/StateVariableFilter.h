@@ -0,0 +1,73 @@
+#pragma once
+
+#include "FloatLanes.h"
+
+// Topology-preserving (trapezoidal) state-variable filter with lowpass, bandpass and highpass
+// responses. Every channel keeps its state in its own lane of one FloatLanes register, so a whole
+// frame is filtered by a single stream of vector instructions. Coefficients are recomputed at
+// block rate only, gliding towards the target.
+class StateVariableFilter
+{
+public:
+    enum class Mode
+    {
+        Lowpass,
+        Bandpass,
+        Highpass
+    };
+
+    static constexpr int numLanes = FloatLanes::size;
+    using Frame = FloatLanes::Array;
+
+    // Clears the state; the next coefficient update jumps straight to the target.
+    void prepare(double sampleRate);
+    void reset();
+
+    // Resonance 0..1 runs Q from 0.707 (Butterworth) to about 10. The bandpass is normalised to
+    // unity gain at the cutoff. Takes effect at the next updateCoefficients().
+    void setTarget(float cutoffHz, float resonance, Mode mode);
+
+    // Moves the cutoff and resonance towards the target as if numSamples had passed (a 10 ms
+    // glide) and derives the coefficients for the next block. 0 jumps straight to the target.
+    void updateCoefficients(int numSamples);
+
+    float getCutoff() const { return cutoff; }
+    float getResonance() const { return resonance; }
+    bool isSettled() const { return cutoff == targetCutoff && resonance == targetResonance; }
+
+    // Filters one sample per lane. Unused lanes should carry zeros.
+    FloatLanes process(FloatLanes input)
+    {
+        const auto two = FloatLanes::expand(2.0f);
+        const auto v3 = input - ic2;
+        const auto v1 = a1 * ic1 + a2 * v3;
+        const auto v2 = ic2 + a2 * ic1 + a3 * v3;
+        ic1 = two * v1 - ic1;
+        ic2 = two * v2 - ic2;
+        return m0 * input + m1 * v1 + m2 * v2;
+    }
+
+    void processFrame(Frame& frame) { process(FloatLanes::fromArray(frame)).store(frame.data()); }
+
+    // One lane on its own, for callers with a single channel. Runs the same lane arithmetic as
+    // processFrame and leaves the other lanes' state as it was.
+    float processSample(int lane, float input);
+
+private:
+    double sampleRate = 44100.0;
+    Mode mode = Mode::Lowpass;
+    float targetCutoff = 1000.0f;
+    float targetResonance = 0.0f;
+    float cutoff = 1000.0f;
+    float resonance = 0.0f;
+    bool primed = false;
+
+    FloatLanes a1 = FloatLanes::expand(1.0f);
+    FloatLanes a2;
+    FloatLanes a3;
+    FloatLanes m0;
+    FloatLanes m1;
+    FloatLanes m2 = FloatLanes::expand(1.0f);
+    FloatLanes ic1;
+    FloatLanes ic2;
+};
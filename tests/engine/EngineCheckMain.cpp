@@ -0,0 +1,355 @@
+#include <JuceHeader.h>
+
+#include "PluginProcessor.h"
+#include "cli/BatchRenderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Engine behaviour that only shows with the whole processor running: idle sleep engaging with
+// the default settings, what a sleeping block outputs, sample-exact footswitch timing, presets
+// landing in one block, job values overriding a preset in an offline render, and a loop export
+// giving up when the host stops processing.
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 256;
+
+    struct Checks
+    {
+        void expect(bool condition, const std::string& what)
+        {
+            ++count;
+            if (!condition)
+                failures.push_back(what);
+        }
+
+        std::vector<std::string> failures;
+        int count = 0;
+    };
+
+    void prepare(SixteenSecondAudioProcessor& processor, int blockSize = kBlockSize)
+    {
+        processor.setPlayConfigDetails(2, 2, kSampleRate, blockSize);
+        processor.setNonRealtime(true);
+        processor.prepareToPlay(kSampleRate, blockSize);
+    }
+
+    void setParameter(SixteenSecondAudioProcessor& processor, const char* id, float value)
+    {
+        auto* parameter = processor.getAPVTS().getParameter(id);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    int findProgram(SixteenSecondAudioProcessor& processor, const juce::String& name)
+    {
+        for (int i = 0; i < processor.getNumPrograms(); ++i)
+        {
+            if (processor.getProgramName(i) == name)
+                return i;
+        }
+        return -1;
+    }
+
+    void checkIdleSleep(Checks& checks)
+    {
+        SixteenSecondAudioProcessor processor;
+        prepare(processor);
+
+        juce::AudioBuffer<float> block(2, kBlockSize);
+        juce::MidiBuffer midi;
+
+        // Half a second of tone into the default delay, then silence until the tail has died out.
+        const auto toneSamples = static_cast<juce::int64>(kSampleRate / 2.0);
+        const auto maxBlocks = static_cast<int>(kSampleRate * 30.0) / kBlockSize;
+        juce::int64 position = 0;
+        for (int b = 0; b < maxBlocks && !processor.isSleeping(); ++b)
+        {
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int i = 0; i < kBlockSize; ++i)
+                {
+                    const auto time = position + i;
+                    block.setSample(channel, i, time < toneSamples ? 0.5f * std::sin(0.05f * static_cast<float>(time)) : 0.0f);
+                }
+            }
+
+            processor.processBlock(block, midi);
+            position += kBlockSize;
+        }
+
+        checks.expect(processor.isSleeping(), "sleeps with the default parameters once the tail has decayed");
+        checks.expect(position > toneSamples, "stays awake while the tone plays");
+
+        // Asleep, only the dry path is heard: silence in is exact silence out, with no held value.
+        for (int b = 0; b < 4; ++b)
+        {
+            block.clear();
+            processor.processBlock(block, midi);
+            checks.expect(block.getMagnitude(0, 0, kBlockSize) == 0.0f && block.getMagnitude(1, 0, kBlockSize) == 0.0f,
+                          "silent input while asleep gives silent output");
+        }
+
+        // Sub-threshold input passes through dry, scaled by the mix's dry gain (Mix 0.5 by default).
+        const auto level = 5.0e-5f;
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < kBlockSize; ++i)
+                block.setSample(channel, i, level);
+        processor.processBlock(block, midi);
+
+        const auto expected = level * std::cos(0.5f * juce::MathConstants<float>::halfPi);
+        checks.expect(processor.isSleeping(), "sub-threshold input keeps it asleep");
+        checks.expect(std::abs(block.getSample(0, 0) - expected) < 1.0e-9f
+                          && std::abs(block.getSample(1, kBlockSize - 1) - expected) < 1.0e-9f,
+                      "sub-threshold input passes through the dry path while asleep");
+    }
+
+    // Footswitch presses split the block at their sample offset, so a loop recorded between two
+    // presses of Record is exactly as long as the distance between them, whatever the block size.
+    void checkFootswitchTiming(Checks& checks)
+    {
+        constexpr auto recordController = MidiFootswitchMap::defaultFirstController
+                                          + static_cast<int>(FootswitchAction::Record);
+        constexpr juce::int64 firstPress = 777;
+        constexpr juce::int64 secondPress = firstPress + 30011;
+        const std::pair<juce::int64, int> events[] = {
+            { firstPress, 127 }, { firstPress + 3, 0 }, { secondPress, 127 }, { secondPress + 5, 0 }
+        };
+
+        for (const auto blockSize : { 64, 512, 1024 })
+        {
+            const auto label = "blocks of " + std::to_string(blockSize);
+            SixteenSecondAudioProcessor processor;
+            prepare(processor, blockSize);
+
+            juce::AudioBuffer<float> block(2, blockSize);
+            juce::MidiBuffer midi;
+            for (juce::int64 position = 0; position < secondPress + 4 * blockSize; position += blockSize)
+            {
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < blockSize; ++i)
+                        block.setSample(channel, i, 0.25f * std::sin(0.05f * static_cast<float>(position + i)));
+
+                midi.clear();
+                for (const auto& [time, value] : events)
+                {
+                    if (time >= position && time < position + blockSize)
+                        midi.addEvent(juce::MidiMessage::controllerEvent(1, recordController, value),
+                                      static_cast<int>(time - position));
+                }
+
+                processor.processBlock(block, midi);
+            }
+
+            EngineStatus status;
+            checks.expect(processor.getEngineStatus(status) && status.state == LoopState::Idle,
+                          label + ": the second press stops recording");
+            checks.expect(status.loopLength == static_cast<int>(secondPress - firstPress),
+                          label + ": loop length is the distance between the presses");
+        }
+    }
+
+    // A preset's transport and direction switches land in the same block as its other values,
+    // before the host parameters are updated and with no message loop running at all.
+    void checkPresetSwitches(Checks& checks)
+    {
+        for (const auto* name : { "Half-speed Ghosts", "Reverse Smear" })
+        {
+            const auto label = std::string(name);
+            SixteenSecondAudioProcessor processor;
+            prepare(processor);
+
+            juce::AudioBuffer<float> block(2, kBlockSize);
+            juce::MidiBuffer midi;
+            const auto processTone = [&](int blocks)
+            {
+                for (int b = 0; b < blocks; ++b)
+                {
+                    for (int channel = 0; channel < 2; ++channel)
+                        for (int i = 0; i < kBlockSize; ++i)
+                            block.setSample(channel, i, 0.25f * std::sin(0.05f * static_cast<float>(i)));
+                    processor.processBlock(block, midi);
+                }
+            };
+
+            setParameter(processor, "record", 1.0f);
+            processTone(64);
+            setParameter(processor, "record", 0.0f);
+            setParameter(processor, "play", 1.0f);
+            processTone(4);
+
+            EngineStatus status;
+            checks.expect(processor.getEngineStatus(status) && status.state == LoopState::Play,
+                          label + ": a loop is playing before the switch");
+
+            const auto program = findProgram(processor, name);
+            checks.expect(program >= 0, label + ": preset exists");
+            processor.setCurrentProgram(program);
+            processTone(1);
+
+            const auto wantsReverse = label == "Reverse Smear";
+            checks.expect(processor.getEngineStatus(status) && status.state == LoopState::Idle,
+                          label + ": play stops in the first block");
+            checks.expect(status.reverse == wantsReverse && status.halfSpeed == !wantsReverse,
+                          label + ": direction and speed switch in the first block");
+            checks.expect(processor.getAPVTS().getRawParameterValue("play")->load() > 0.5f,
+                          label + ": ahead of the host parameters");
+
+            // The host parameters catching up changes nothing the engine already runs.
+            processor.flushPresetNotification();
+            processTone(4);
+            checks.expect(processor.getEngineStatus(status) && status.state == LoopState::Idle
+                              && status.reverse == wantsReverse && status.halfSpeed == !wantsReverse,
+                          label + ": unchanged once the host parameters follow");
+        }
+    }
+
+    // A job's up-front values override its preset from the first sample, whether the preset is
+    // named or numbered. Fully dry at unity with the limiter off, the render is the input.
+    void checkBatchRenderOverrides(Checks& checks)
+    {
+        const auto directory = juce::File::createTempFile("engine-check");
+        directory.createDirectory();
+        const auto input = directory.getChildFile("in.wav");
+
+        const auto length = static_cast<int>(kSampleRate / 4.0);
+        juce::AudioBuffer<float> source(1, length);
+        for (int i = 0; i < length; ++i)
+            source.setSample(0, i, 0.25f * std::sin(0.05f * static_cast<float>(i)));
+
+        {
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer(
+                wav.createWriterFor(new juce::FileOutputStream(input), kSampleRate, 1, 24, {}, 0));
+            checks.expect(writer != nullptr && writer->writeFromAudioSampleBuffer(source, 0, length),
+                          "writes the render input");
+        }
+
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> inputReader(formats.createReaderFor(input));
+        juce::AudioBuffer<float> expected(1, length);
+        if (inputReader != nullptr)
+            inputReader->read(&expected, 0, length, 0, true, false);
+
+        for (const auto* preset : { "\"Unsafe Fripp Wash\"", "3" })
+        {
+            const auto label = std::string("preset=") + preset;
+            RenderJob job;
+            juce::String error;
+            const auto line = juce::String("in=in.wav out=out.wav mix=0 outputGain=0 limiter=0 preset=") + preset;
+            checks.expect(BatchRenderer::parseJob(line, directory, job, error), label + " job parses");
+
+            const auto result = BatchRenderer::render(job, kBlockSize, 4096);
+            checks.expect(result.ok, label + " renders");
+
+            std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(job.output));
+            checks.expect(reader != nullptr && reader->lengthInSamples == length, label + " writes the whole render");
+            if (reader == nullptr)
+                continue;
+
+            juce::AudioBuffer<float> rendered(1, length);
+            reader->read(&rendered, 0, length, 0, true, false);
+
+            auto maxError = 0.0f;
+            for (int i = 0; i < length; ++i)
+                maxError = std::max(maxError, std::abs(rendered.getSample(0, i) - expected.getSample(0, i)));
+            checks.expect(maxError < 1.0e-5f, label + " overrides apply from sample 0");
+        }
+
+        directory.deleteRecursively();
+    }
+    LoopExporter::Status waitForExport(SixteenSecondAudioProcessor& processor, juce::AudioBuffer<float>* block,
+                                       std::chrono::milliseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        juce::MidiBuffer midi;
+        auto status = processor.getExportStatus();
+        for (; std::chrono::steady_clock::now() < deadline; status = processor.getExportStatus())
+        {
+            if (status != LoopExporter::Status::Capturing && status != LoopExporter::Status::Writing)
+                break;
+
+            if (block != nullptr)
+                processor.processBlock(*block, midi);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        return status;
+    }
+
+    // An export waits for the audio thread to copy the loop. With no blocks coming it reports
+    // Interrupted instead of waiting forever, and exporting works again once audio resumes.
+    void checkStalledExport(Checks& checks)
+    {
+        constexpr auto recordController = MidiFootswitchMap::defaultFirstController
+                                          + static_cast<int>(FootswitchAction::Record);
+        SixteenSecondAudioProcessor processor;
+        prepare(processor);
+
+        juce::AudioBuffer<float> block(2, kBlockSize);
+        juce::MidiBuffer midi;
+        constexpr int loopBlocks = 200;
+        for (int b = 0; b <= loopBlocks + 1; ++b)
+        {
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < kBlockSize; ++i)
+                    block.setSample(channel, i, 0.25f * std::sin(0.05f * static_cast<float>(b * kBlockSize + i)));
+
+            midi.clear();
+            if (b == 0 || b == loopBlocks)
+                midi.addEvent(juce::MidiMessage::controllerEvent(1, recordController, 127), 0);
+            else if (b == 1 || b == loopBlocks + 1)
+                midi.addEvent(juce::MidiMessage::controllerEvent(1, recordController, 0), 0);
+            processor.processBlock(block, midi);
+        }
+
+        const auto directory = juce::File::createTempFile("engine-check");
+        directory.createDirectory();
+        const auto file = directory.getChildFile("loop.wav");
+
+        checks.expect(processor.exportLoop(file), "a stalled export starts");
+        checks.expect(waitForExport(processor, nullptr, std::chrono::seconds(10)) == LoopExporter::Status::Interrupted,
+                      "a stalled export reports Interrupted");
+        checks.expect(!file.existsAsFile(), "a stalled export writes nothing");
+
+        // Audio resumes: the cancelled capture is let go of at the next block.
+        auto started = false;
+        for (int attempt = 0; attempt < 500 && !started; ++attempt)
+        {
+            processor.processBlock(block, midi);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            started = processor.exportLoop(file);
+        }
+        checks.expect(started, "exporting works again once audio resumes");
+        checks.expect(waitForExport(processor, &block, std::chrono::seconds(10)) == LoopExporter::Status::Done,
+                      "the next export completes");
+        checks.expect(file.existsAsFile(), "the next export writes the file");
+
+        directory.deleteRecursively();
+    }
+}
+
+int main()
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    Checks checks;
+
+    checkIdleSleep(checks);
+    checkFootswitchTiming(checks);
+    checkPresetSwitches(checks);
+    checkBatchRenderOverrides(checks);
+    checkStalledExport(checks);
+
+    for (const auto& failure : checks.failures)
+        std::cout << "  FAIL  " << failure << "\n";
+
+    std::cout << checks.count << " checks, " << checks.failures.size() << " failed" << std::endl;
+    return checks.failures.empty() ? 0 : 1;
+}
@@ -0,0 +1,249 @@
+#include <JuceHeader.h>
+
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// CPU budget gate: renders worst-case engine settings through the real processor at 96 kHz in
+// 32-sample blocks and fails when the mean time per block, normalised by a calibration loop,
+// exceeds a fraction of the realtime deadline.
+namespace
+{
+    constexpr double kSampleRate = 96000.0;
+    constexpr int kBlockSize = 32;
+    constexpr double kDefaultBudget = 0.25;
+    // Seconds per calibration block on the reference machine (a 3 GHz desktop core, release build).
+    constexpr double kReferenceCalibrationSeconds = 2.0e-6;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Step
+    {
+        double seconds = 0.0;
+        const char* parameterId = nullptr;
+        float value = 0.0f;
+    };
+
+    struct Scenario
+    {
+        const char* name = nullptr;
+        std::vector<Step> steps;
+        // Audio rendered untimed (recording the loop, settling ramps) before timing starts.
+        double setupSeconds = 0.0;
+    };
+
+    struct Measurement
+    {
+        double meanSeconds = 0.0;
+        double worstSeconds = 0.0;
+    };
+
+    std::vector<Scenario> makeScenarios()
+    {
+        return {
+            { "overdub, max grit",
+              { { 0.0, "noise", 1.0f },
+                { 0.0, "filter", 1.0f },
+                { 0.0, "erodeAmount", 1.0f },
+                { 0.0, "feedback", 1.0f },
+                { 0.0, "hqPlayback", 1.0f },
+                { 0.0, "record", 1.0f },
+                { 1.5, "record", 0.0f },
+                { 1.5, "play", 1.0f },
+                { 1.6, "overdub", 1.0f } },
+              1.7 },
+            { "authentic, heavy modulation",
+              { { 0.0, "authentic", 1.0f },
+                { 0.0, "delayTime", 1500.0f },
+                { 0.0, "feedback", 1.1f },
+                { 0.0, "modDepth", 1.0f },
+                { 0.0, "modSpeed", 1.0f },
+                { 0.0, "noise", 0.5f } },
+              0.5 },
+            { "safe-ish, linear reads",
+              { { 0.0, "authentic", 0.0f },
+                { 0.0, "hqPlayback", 0.0f },
+                { 0.0, "speed", 0.7f },
+                { 0.0, "modDepth", 0.5f },
+                { 0.0, "record", 1.0f },
+                { 1.0, "record", 0.0f },
+                { 1.0, "play", 1.0f } },
+              1.2 },
+            { "taps at the write head",
+              { { 0.0, "delayTime", 40.0f },
+                { 0.0, "tap1Time", 0.0f },
+                { 0.0, "tap1Level", 1.0f },
+                { 0.0, "tap2Time", 0.05f },
+                { 0.0, "tap2Level", 0.5f },
+                { 0.0, "tap2Feedback", 0.3f },
+                { 0.0, "tap3Level", 0.5f },
+                { 0.0, "tap4Feedback", 0.2f } },
+              0.2 },
+        };
+    }
+
+    // Deterministic non-silent input, so idle sleep never kicks in.
+    void fillInput(juce::AudioBuffer<float>& buffer, juce::int64 position)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* data = buffer.getWritePointer(channel);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const auto t = static_cast<double>(position + i) / kSampleRate;
+                const auto tone = std::sin(juce::MathConstants<double>::twoPi * (220.0 + 110.0 * channel) * t);
+                data[i] = static_cast<float>(0.3 * tone + 0.05 * std::sin(7919.0 * t * t));
+            }
+        }
+    }
+
+    Measurement render(const Scenario& scenario, double timedSeconds)
+    {
+        SixteenSecondAudioProcessor processor;
+        auto& state = processor.getAPVTS();
+        processor.setPlayConfigDetails(2, 2, kSampleRate, kBlockSize);
+        processor.setNonRealtime(true);
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+        processor.setNonRealtime(false);
+
+        juce::AudioBuffer<float> block(2, kBlockSize);
+        juce::MidiBuffer midi;
+        const auto setupSamples = static_cast<juce::int64>(scenario.setupSeconds * kSampleRate);
+        const auto totalSamples = setupSamples + static_cast<juce::int64>(timedSeconds * kSampleRate);
+        size_t nextStep = 0;
+        double total = 0.0;
+        double worst = 0.0;
+        juce::int64 timedBlocks = 0;
+
+        for (juce::int64 position = 0; position + kBlockSize <= totalSamples; position += kBlockSize)
+        {
+            for (; nextStep < scenario.steps.size()
+                   && static_cast<juce::int64>(scenario.steps[nextStep].seconds * kSampleRate) <= position;
+                 ++nextStep)
+            {
+                auto* parameter = state.getParameter(scenario.steps[nextStep].parameterId);
+                jassert(parameter != nullptr);
+                parameter->setValueNotifyingHost(parameter->convertTo0to1(scenario.steps[nextStep].value));
+            }
+
+            fillInput(block, position);
+            const auto start = Clock::now();
+            processor.processBlock(block, midi);
+            const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            if (position >= setupSamples)
+            {
+                total += elapsed;
+                worst = std::max(worst, elapsed);
+                ++timedBlocks;
+            }
+        }
+
+        processor.releaseResources();
+        return { timedBlocks > 0 ? total / static_cast<double>(timedBlocks) : 0.0, worst };
+    }
+
+    // A fixed scalar workload shaped like the engine's inner loops (one-pole filters, multiplies,
+    // a saturator) in 32-sample stereo blocks. Best of several runs, in seconds per block.
+    double calibrate()
+    {
+        constexpr int blocks = 20000;
+        float state[2] = { 0.0f, 0.0f };
+        float samples[2][kBlockSize];
+        volatile float sink = 0.0f;
+        auto best = 1.0e9;
+
+        for (int run = 0; run < 5; ++run)
+        {
+            const auto start = Clock::now();
+            for (int b = 0; b < blocks; ++b)
+            {
+                for (int c = 0; c < 2; ++c)
+                {
+                    for (int i = 0; i < kBlockSize; ++i)
+                    {
+                        const auto x = static_cast<float>((b * kBlockSize + i + c * 7) % 97) * 0.01f - 0.48f;
+                        state[c] += 0.2f * (x - state[c]);
+                        samples[c][i] = std::tanh(state[c] * 1.5f) * 0.9f;
+                    }
+                }
+
+                sink = sink + samples[0][b % kBlockSize] + samples[1][(b + 5) % kBlockSize];
+            }
+
+            best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count() / blocks);
+        }
+
+        return best;
+    }
+
+    void printUsage()
+    {
+        std::cout << "Usage: 16SecondPerf [--budget F] [--seconds S]\n"
+                     "\n"
+                     "  --budget F   allowed fraction of the 32-sample deadline at 96 kHz, on the reference\n"
+                     "               machine (default 0.25, or SIXTEEN_SECOND_CPU_BUDGET)\n"
+                     "  --seconds S  audio timed per scenario (default 3)\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    auto budget = kDefaultBudget;
+    auto seconds = 3.0;
+    if (const auto* fromEnvironment = std::getenv("SIXTEEN_SECOND_CPU_BUDGET"))
+        budget = juce::String(fromEnvironment).getDoubleValue();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg(argv[i]);
+        const auto hasValue = i + 1 < argc;
+
+        if (arg == "--budget" && hasValue)
+            budget = juce::String(argv[++i]).getDoubleValue();
+        else if (arg == "--seconds" && hasValue)
+            seconds = std::max(0.1, juce::String(argv[++i]).getDoubleValue());
+        else
+        {
+            printUsage();
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    if (budget <= 0.0)
+    {
+        std::cerr << "Budget must be positive\n";
+        return 1;
+    }
+
+    const auto deadline = kBlockSize / kSampleRate;
+    const auto calibration = calibrate();
+    const auto speed = calibration / kReferenceCalibrationSeconds;
+    std::cout << "Calibration: " << juce::String(calibration * 1.0e6, 3) << " us per block ("
+              << juce::String(speed, 2) << "x the reference machine), deadline "
+              << juce::String(deadline * 1.0e6, 1) << " us, budget " << juce::String(budget * 100.0, 1) << "%"
+              << std::endl;
+
+    auto failures = 0;
+    for (const auto& scenario : makeScenarios())
+    {
+        const auto measurement = render(scenario, seconds);
+        const auto load = measurement.meanSeconds / speed / deadline;
+        const auto passed = load <= budget;
+        failures += passed ? 0 : 1;
+
+        std::cout << (passed ? "  ok    " : "  SLOW  ") << scenario.name << ": mean "
+                  << juce::String(measurement.meanSeconds * 1.0e6, 2) << " us, worst "
+                  << juce::String(measurement.worstSeconds * 1.0e6, 1) << " us, normalised load "
+                  << juce::String(load * 100.0, 1) << "%" << std::endl;
+    }
+
+    return failures > 0 ? 1 : 0;
+}
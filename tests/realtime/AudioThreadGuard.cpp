@@ -0,0 +1,186 @@
+#include "AudioThreadGuard.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <dlfcn.h>
+#include <pthread.h>
+#endif
+
+namespace
+{
+    thread_local bool guarded = false;
+    std::atomic<std::uint64_t> allocations { 0 };
+    std::atomic<std::uint64_t> frees { 0 };
+    std::atomic<std::uint64_t> locks { 0 };
+
+    void note(std::atomic<std::uint64_t>& counter)
+    {
+        if (guarded)
+            counter.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#if defined(__GLIBC__)
+extern "C"
+{
+    // glibc's own entry points, which the interposed functions forward to.
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* pointer);
+
+    void* malloc(size_t size) noexcept
+    {
+        note(allocations);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        note(allocations);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size) noexcept
+    {
+        note(allocations);
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void* pointer) noexcept
+    {
+        if (pointer != nullptr)
+            note(frees);
+        __libc_free(pointer);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        note(allocations);
+        return __libc_memalign(alignment, size);
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept
+    {
+        note(allocations);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        note(allocations);
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : 12; // ENOMEM
+    }
+
+    // Resolved on first use without a function-local static: its guard could itself lock.
+    using LockFunction = int (*)(pthread_mutex_t*);
+    LockFunction realLock = nullptr;
+    LockFunction realTryLock = nullptr;
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        note(locks);
+        if (realLock == nullptr)
+            realLock = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+        return realLock(mutex);
+    }
+
+    int pthread_mutex_trylock(pthread_mutex_t* mutex) noexcept
+    {
+        note(locks);
+        if (realTryLock == nullptr)
+            realTryLock = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_trylock"));
+        return realTryLock(mutex);
+    }
+}
+
+namespace
+{
+    void* allocate(std::size_t size) { return __libc_malloc(size == 0 ? 1 : size); }
+    void release(void* pointer) { __libc_free(pointer); }
+}
+#else
+namespace
+{
+    void* allocate(std::size_t size) { return std::malloc(size == 0 ? 1 : size); }
+    void release(void* pointer) { std::free(pointer); }
+}
+#endif
+
+void* operator new(std::size_t size)
+{
+    note(allocations);
+    if (auto* pointer = allocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    note(allocations);
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer != nullptr)
+        note(frees);
+    release(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+namespace AudioThreadGuard
+{
+    Scope::Scope() { guarded = true; }
+    Scope::~Scope() { guarded = false; }
+
+    Counts getCounts()
+    {
+        return { allocations.load(), frees.load(), locks.load() };
+    }
+
+    void reset()
+    {
+        allocations.store(0);
+        frees.store(0);
+        locks.store(0);
+    }
+
+    bool watchesMallocAndLocks()
+    {
+#if defined(__GLIBC__)
+        return true;
+#else
+        return false;
+#endif
+    }
+}
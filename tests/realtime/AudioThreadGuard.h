@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+// Counts heap allocations, frees and mutex locks made by the current thread while a Scope is
+// open. Linking AudioThreadGuard.cpp replaces operator new/delete everywhere; with glibc it
+// also interposes malloc/calloc/realloc/free, the aligned allocators and pthread_mutex_lock,
+// so C allocations and juce::CriticalSection/std::mutex locks are caught too.
+namespace AudioThreadGuard
+{
+    struct Counts
+    {
+        std::uint64_t allocations = 0;
+        std::uint64_t frees = 0;
+        std::uint64_t locks = 0;
+
+        bool isClean() const { return allocations == 0 && frees == 0 && locks == 0; }
+    };
+
+    class Scope
+    {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // Totals recorded inside scopes since the last reset.
+    Counts getCounts();
+    void reset();
+
+    // False when only operator new/delete can be watched on this platform.
+    bool watchesMallocAndLocks();
+}
@@ -0,0 +1,251 @@
+#include <JuceHeader.h>
+
+#include "AudioThreadGuard.h"
+#include "PluginProcessor.h"
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Realtime-safety harness: drives the processor through every loop state, mode toggle, preset,
+// parameter sweep, footswitch and re-prepare, and fails if processBlock allocates, frees or
+// takes a lock. Changes are applied between blocks, outside the guarded scope, like a host's
+// message thread would.
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 256;
+
+    class Harness
+    {
+    public:
+        Harness()
+        {
+            processor.setPlayConfigDetails(2, 2, kSampleRate, kBlockSize);
+            processor.setNonRealtime(true);
+            processor.prepareToPlay(kSampleRate, kBlockSize);
+            processor.setNonRealtime(false);
+        }
+
+        void set(const char* id, float value)
+        {
+            auto* parameter = processor.getAPVTS().getParameter(id);
+            jassert(parameter != nullptr);
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        }
+
+        // Renders `blocks` blocks of input under the guard and records any violation against `step`.
+        void run(const std::string& step, int blocks, int blockSize = kBlockSize, bool doublePrecision = false,
+                 const juce::MidiBuffer& midi = {})
+        {
+            floatBlock.setSize(2, blockSize, false, false, true);
+            doubleBlock.setSize(2, blockSize, false, false, true);
+            auto events = midi;
+            events.ensureSize(4096);
+
+            for (int b = 0; b < blocks; ++b)
+            {
+                fillInput(blockSize);
+                auto& blockMidi = b == 0 ? events : empty;
+
+                AudioThreadGuard::reset();
+                {
+                    AudioThreadGuard::Scope guard;
+                    if (doublePrecision)
+                        processor.processBlock(doubleBlock, blockMidi);
+                    else
+                        processor.processBlock(floatBlock, blockMidi);
+                }
+
+                const auto counts = AudioThreadGuard::getCounts();
+                if (!counts.isClean())
+                {
+                    failures.push_back(step + " (block " + std::to_string(b) + "): "
+                                       + std::to_string(counts.allocations) + " allocations, "
+                                       + std::to_string(counts.frees) + " frees, "
+                                       + std::to_string(counts.locks) + " locks");
+                    return;
+                }
+            }
+
+            ++steps;
+        }
+
+        SixteenSecondAudioProcessor processor;
+        std::vector<std::string> failures;
+        int steps = 0;
+
+    private:
+        void fillInput(int blockSize)
+        {
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    const auto value = 0.25 * std::sin(0.031 * static_cast<double>(position + i) + channel);
+                    floatBlock.setSample(channel, i, static_cast<float>(value));
+                    doubleBlock.setSample(channel, i, value);
+                }
+            }
+
+            position += blockSize;
+        }
+
+        juce::AudioBuffer<float> floatBlock;
+        juce::AudioBuffer<double> doubleBlock;
+        juce::MidiBuffer empty;
+        juce::int64 position = 0;
+    };
+
+    juce::MidiBuffer makeFootswitch(int controller)
+    {
+        juce::MidiBuffer midi;
+        midi.addEvent(juce::MidiMessage::controllerEvent(1, controller, 127), 17);
+        midi.addEvent(juce::MidiMessage::controllerEvent(1, controller, 0), 90);
+        return midi;
+    }
+}
+
+int main()
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    Harness harness;
+
+    if (!AudioThreadGuard::watchesMallocAndLocks())
+        std::cout << "Note: only operator new/delete are watched on this platform\n";
+
+    // Warm-up: the first block adopts the provisioned delay memory.
+    harness.run("warm-up", 4);
+
+    // Loop states.
+    harness.set("record", 1.0f);
+    harness.run("record", 40);
+    harness.set("record", 0.0f);
+    harness.set("play", 1.0f);
+    harness.run("play", 20);
+    harness.set("overdub", 1.0f);
+    harness.run("overdub", 20);
+
+    // Exporting the loop while overdubbing: the snapshot is copied on the audio thread in place.
+    const auto exportFile = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getChildFile("16SecondRealtimeCheck.wav");
+    harness.processor.exportLoop(exportFile);
+    harness.run("overdub during export", 20);
+
+    harness.set("reverse", 1.0f);
+    harness.run("overdub reversed", 10);
+    harness.set("halfSpeed", 1.0f);
+    harness.run("overdub half-speed", 10);
+    harness.set("overdub", 0.0f);
+    harness.run("play half-speed reversed", 10);
+    harness.set("reverse", 0.0f);
+    harness.set("halfSpeed", 0.0f);
+    harness.set("play", 0.0f);
+    harness.run("stop", 10);
+    harness.set("clear", 1.0f);
+    harness.run("clear", 2);
+    harness.set("clear", 0.0f);
+
+    // Importing a file as the loop: pages stream into memory on the audio thread, then it plays.
+    juce::File importFile;
+    {
+        juce::WavAudioFormat wav;
+        juce::AudioBuffer<float> tone(2, static_cast<int>(kSampleRate) / 2);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < tone.getNumSamples(); ++i)
+                tone.setSample(channel, i, 0.25f * std::sin(0.02f * static_cast<float>(i)));
+
+        importFile = exportFile.getSiblingFile("16SecondRealtimeImport.wav");
+        importFile.deleteFile();
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wav.createWriterFor(new juce::FileOutputStream(importFile), kSampleRate, 2, 24, {}, 0));
+        if (writer != nullptr)
+            writer->writeFromAudioSampleBuffer(tone, 0, tone.getNumSamples());
+    }
+    harness.processor.importLoop(importFile);
+    for (int wait = 0; wait < 200 && harness.processor.getImportStatus() == LoopImporter::Status::Loading; ++wait)
+    {
+        harness.run("import", 1);
+        juce::Thread::sleep(1);
+    }
+    // The engine turned Play on itself; bring the parameter along as the editor's timer would.
+    harness.set("play", 1.0f);
+    harness.run("play imported loop", 10);
+    harness.set("play", 0.0f);
+    harness.run("stop imported loop", 2);
+
+    // Footswitches: CC 80 Record, 81 Play, 82 Overdub, 83 Clear, 84 Reverse, 85 Half-speed.
+    for (int controller = 80; controller <= 85; ++controller)
+        harness.run("footswitch CC " + std::to_string(controller), 6, kBlockSize, false, makeFootswitch(controller));
+
+    // Mode toggles, each with a loop running.
+    harness.set("record", 1.0f);
+    harness.run("record again", 20);
+    harness.set("record", 0.0f);
+    harness.set("play", 1.0f);
+    for (const auto* toggle : { "authentic", "hqPlayback", "cleanCapture", "limiter" })
+    {
+        for (const auto value : { 1.0f, 0.0f })
+        {
+            harness.set(toggle, value);
+            harness.run(std::string(toggle) + (value > 0.5f ? " on" : " off"), 6);
+        }
+    }
+
+    // Every parameter swept across its range.
+    for (auto* parameter : harness.processor.getParameters())
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        if (ranged == nullptr || ranged->getParameterID() == "clear")
+            continue;
+
+        for (int step = 0; step <= 8; ++step)
+        {
+            ranged->setValueNotifyingHost(static_cast<float>(step) / 8.0f);
+            harness.run("sweep " + ranged->getParameterID().toStdString(), 2);
+        }
+    }
+
+    // Presets, including a switch while the previous ramp is still running.
+    for (int program = 0; program < harness.processor.getNumPrograms(); ++program)
+    {
+        harness.processor.setCurrentProgram(program);
+        harness.run("preset " + std::to_string(program), 1);
+        harness.processor.flushPresetNotification();
+        harness.run("preset " + std::to_string(program) + " synced", 8);
+    }
+
+    // Host block sizes, double precision, and a double block larger than the prepared size.
+    for (const auto size : { 1, 31, 64, 512 })
+        harness.run("block size " + std::to_string(size), 8, size);
+    harness.run("double precision", 8, kBlockSize, true);
+    harness.run("double precision oversized", 4, kBlockSize * 4 + 3, true, makeFootswitch(84));
+
+    // Re-preparing: same rate is a no-op, a new rate swaps resampled memory in on the audio thread.
+    harness.processor.prepareToPlay(kSampleRate, kBlockSize);
+    harness.run("re-prepare same rate", 4);
+    harness.processor.setRateAndBufferSizeDetails(kSampleRate * 2.0, kBlockSize);
+    harness.processor.setNonRealtime(true);
+    harness.processor.prepareToPlay(kSampleRate * 2.0, kBlockSize);
+    harness.processor.setNonRealtime(false);
+    harness.run("re-prepare new rate", 8);
+
+    // Session state restored mid-stream.
+    juce::MemoryBlock state;
+    harness.processor.getStateInformation(state);
+    harness.processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    harness.run("state restore", 4);
+
+    harness.processor.releaseResources();
+    exportFile.deleteFile();
+    importFile.deleteFile();
+
+    for (const auto& failure : harness.failures)
+        std::cout << "  FAIL  " << failure << "\n";
+
+    std::cout << harness.steps << " steps clean, " << harness.failures.size() << " with audio-thread allocations or locks"
+              << std::endl;
+    return harness.failures.empty() ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/BufferProvisioner.h"
+
+namespace
+{
+    MemoryBuffer makeRamp(int channels, int size, int writeIndex)
+    {
+        MemoryBuffer buffer;
+        buffer.prepare(channels, size);
+        for (int c = 0; c < channels; ++c)
+            for (int i = 0; i < size; ++i)
+                buffer.writeSample(c, i, static_cast<float>(i + 1000 * c) / 16384.0f);
+
+        buffer.setWriteIndex(writeIndex);
+        return buffer;
+    }
+
+    float rampValue(int channel, int index)
+    {
+        return static_cast<float>(index + 1000 * channel) / 16384.0f;
+    }
+}
+
+TEST_CASE("BufferProvisioner swaps a grown buffer in with the content intact", "[provisioner]")
+{
+    BufferProvisioner provisioner;
+    auto current = makeRamp(2, 100, 30);
+    BufferProvisioner::Placement placement;
+
+    REQUIRE_FALSE(provisioner.take(current, placement));
+
+    provisioner.request({ 2, 400, SampleFormat::Float32, 48000.0 }, { &current, 48000.0 });
+    REQUIRE(provisioner.isPending());
+    provisioner.waitUntilReady();
+    REQUIRE(provisioner.take(current, placement));
+    REQUIRE_FALSE(provisioner.isPending());
+
+    REQUIRE(current.getSize() == 400);
+    REQUIRE(placement.sourceSize == 100);
+    REQUIRE(placement.kept == 100);
+    REQUIRE(placement.offset == 30);
+    REQUIRE(current.getWriteIndex() == 100);
+
+    // Oldest first: the sample at the old write head now sits at index 0.
+    for (int c = 0; c < 2; ++c)
+    {
+        for (int i = 0; i < 100; ++i)
+            REQUIRE(current.readSample(c, i) == rampValue(c, (i + 30) % 100));
+
+        REQUIRE(current.readSample(c, 250) == 0.0f);
+    }
+}
+
+TEST_CASE("BufferProvisioner keeps the newest samples when shrinking", "[provisioner]")
+{
+    BufferProvisioner provisioner;
+    auto current = makeRamp(1, 100, 10);
+    BufferProvisioner::Placement placement;
+
+    provisioner.request({ 1, 40, SampleFormat::Float32, 48000.0 }, { &current, 48000.0 });
+    provisioner.waitUntilReady();
+    REQUIRE(provisioner.take(current, placement));
+
+    REQUIRE(placement.kept == 40);
+    REQUIRE(placement.offset == 70);
+    REQUIRE(current.getWriteIndex() == 0);
+    for (int i = 0; i < 40; ++i)
+        REQUIRE(current.readSample(0, i) == rampValue(0, (70 + i) % 100));
+}
+
+TEST_CASE("BufferProvisioner converts the storage format and channel count", "[provisioner]")
+{
+    BufferProvisioner provisioner;
+    auto current = makeRamp(1, 64, 0);
+    BufferProvisioner::Placement placement;
+
+    provisioner.request({ 2, 64, SampleFormat::Int16, 48000.0 }, { &current, 48000.0 });
+    provisioner.waitUntilReady();
+    REQUIRE(provisioner.take(current, placement));
+
+    REQUIRE(current.getFormat() == SampleFormat::Int16);
+    REQUIRE(current.getNumChannels() == 2);
+    for (int i = 0; i < 64; ++i)
+    {
+        REQUIRE(std::abs(current.readSample(0, i) - rampValue(0, i)) < 1.0e-4f);
+        REQUIRE(current.readSample(1, i) == 0.0f);
+    }
+}
+
+TEST_CASE("BufferProvisioner starts empty without a source and supersedes untaken results", "[provisioner]")
+{
+    BufferProvisioner provisioner;
+    auto current = makeRamp(1, 32, 5);
+    BufferProvisioner::Placement placement;
+
+    provisioner.request({ 1, 48, SampleFormat::Float32, 48000.0 }, { &current, 48000.0 });
+    provisioner.request({ 1, 64, SampleFormat::Float32, 48000.0 }, {});
+    provisioner.waitUntilReady();
+    REQUIRE(provisioner.take(current, placement));
+    REQUIRE_FALSE(provisioner.take(current, placement));
+
+    REQUIRE(current.getSize() == 64);
+    REQUIRE(placement.kept == 0);
+    REQUIRE(placement.sourceSize == 0);
+    for (int i = 0; i < 64; ++i)
+        REQUIRE(current.readSample(0, i) == 0.0f);
+
+    provisioner.releaseRetired();
+    REQUIRE_FALSE(provisioner.isPending());
+}
+
+TEST_CASE("BufferProvisioner keeps the loop where the content went", "[provisioner]")
+{
+    BufferProvisioner provisioner;
+    auto current = makeRamp(1, 100, 30);
+    BufferProvisioner::Placement placement;
+
+    // A loop wrapping the buffer end moves with the rest of the content.
+    provisioner.request({ 1, 200, SampleFormat::Float32, 48000.0 }, { &current, 48000.0, 90, 20 });
+    provisioner.waitUntilReady();
+    REQUIRE(provisioner.take(current, placement));
+    REQUIRE(placement.loopStart == 60);
+    REQUIRE(placement.loopLength == 20);
+    REQUIRE(current.readSample(0, 60) == rampValue(0, 90));
+
+    // One that falls out of a shrunk buffer is dropped.
+    provisioner.request({ 1, 30, SampleFormat::Float32, 48000.0 }, { &current, 48000.0, 60, 20 });
+    provisioner.waitUntilReady();
+    REQUIRE(provisioner.take(current, placement));
+    REQUIRE(placement.loopLength == 0);
+}
+
+TEST_CASE("BufferProvisioner resamples content and loop across a rate change", "[provisioner]")
+{
+    constexpr double kPi = 3.14159265358979323846;
+    constexpr int sourceSize = 4800;
+    constexpr int loopLength = 480;
+    MemoryBuffer current;
+    current.prepare(1, sourceSize);
+    for (int i = 0; i < sourceSize; ++i)
+        current.writeSample(0, i, 0.5f * static_cast<float>(std::sin(2.0 * kPi * i / 48.0)));
+    current.setWriteIndex(0);
+
+    BufferProvisioner provisioner;
+    BufferProvisioner::Placement placement;
+    provisioner.request({ 1, sourceSize * 2, SampleFormat::Float32, 96000.0 },
+                        { &current, 48000.0, 1000, loopLength });
+    provisioner.waitUntilReady();
+    REQUIRE(provisioner.take(current, placement));
+
+    REQUIRE(placement.kept == sourceSize);
+    REQUIRE(placement.written == sourceSize * 2);
+    REQUIRE(placement.loopStart == 2000);
+    REQUIRE(placement.loopLength == loopLength * 2);
+    REQUIRE(current.getWriteIndex() == 0);
+
+    // A 1 kHz tone is now 96 samples per cycle, including across the loop seam.
+    float worst = 0.0f;
+    for (int i = 0; i < placement.loopLength; ++i)
+    {
+        const auto expected = 0.5f * static_cast<float>(std::sin(2.0 * kPi * (2000 + i) / 96.0));
+        worst = std::max(worst, std::abs(current.readSample(0, placement.loopStart + i) - expected));
+    }
+    REQUIRE(worst < 1.0e-3f);
+}
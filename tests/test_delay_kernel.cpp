@@ -0,0 +1,290 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "dsp/DelayKernel.h"
+#include "dsp/FeedbackModel.h"
+#include "dsp/MemoryBuffer.h"
+#include "dsp/MultiTap.h"
+
+namespace
+{
+    constexpr int kChannels = 2;
+    constexpr int kChunk = 256;
+
+    bool approxEqual(float a, float b, float eps = 1.0e-6f)
+    {
+        return std::abs(a - b) <= eps;
+    }
+
+    DelayKernel::Flags makeFlags(int index)
+    {
+        return { (index & 1) != 0, (index & 2) != 0, (index & 4) != 0, (index & 8) != 0, (index & 16) != 0 };
+    }
+
+    std::string describe(const DelayKernel::Flags& flags)
+    {
+        return std::string(flags.authentic ? "authentic" : "linear") + (flags.noise ? " noise" : "")
+               + (flags.fading ? " fade" : "") + (flags.tapping ? " taps" : "") + (flags.packed ? " 16-bit" : "");
+    }
+
+    // One engine's worth of delay-line state plus the per-chunk side inputs the kernel reads.
+    struct Rig
+    {
+        explicit Rig(const DelayKernel::Flags& flags, int bufferSize = 4096)
+        {
+            memory.prepare(kChannels, bufferSize, flags.packed ? SampleFormat::Int16 : SampleFormat::Float32);
+            memory.setWriteIndex(bufferSize - 100);
+            degrade.reset(48000.0);
+            degrade.setParameters(0.4f, flags.noise ? 0.3f : 0.0f);
+
+            for (int c = 0; c < kChannels; ++c)
+            {
+                for (int i = 0; i < bufferSize; ++i)
+                    memory.writeSample(c, i, 0.5f * std::sin(0.013f * static_cast<float>(i + 17 * c)));
+
+                for (int i = 0; i < kChunk; ++i)
+                {
+                    const auto k = static_cast<size_t>(c * kChunk + i);
+                    input[k] = 0.3f * std::sin(0.07f * static_cast<float>(i + c));
+                    noise[k] = static_cast<float>((i * 13 + c * 5) % 17) / 17.0f;
+                    fadeRead[k] = 0.2f * std::cos(0.05f * static_cast<float>(i));
+                    tapOutput[k] = 0.01f * static_cast<float>(i % 7);
+                    tapSend[k] = 0.02f * static_cast<float>(i % 5);
+                }
+            }
+
+            for (int i = 0; i < kChunk; ++i)
+            {
+                fadeGains[static_cast<size_t>(i)] = static_cast<float>(i) / static_cast<float>(kChunk);
+                // Swept, fractional and occasionally longer than the write index, so reads wrap.
+                delays[static_cast<size_t>(i)] = 300.0f + 37.25f * std::sin(0.02f * static_cast<float>(i));
+            }
+        }
+
+        DelayKernel::Block makeBlock()
+        {
+            for (int c = 0; c < kChannels; ++c)
+            {
+                const auto offset = static_cast<size_t>(c * kChunk);
+                inputs[c] = input.data() + offset;
+                wets[c] = wet.data() + offset;
+                noises[c] = noise.data() + offset;
+                fadeReads[c] = fadeRead.data() + offset;
+                tapOutputs[c] = tapOutput.data() + offset;
+                tapSends[c] = tapSend.data() + offset;
+            }
+
+            return { inputs, wets, noises, fadeReads, fadeGains.data(), tapOutputs, tapSends, delays.data(),
+                     kChannels, kChunk, nearTaps, 2 };
+        }
+
+        MemoryBuffer memory;
+        FeedbackModel degrade;
+        std::vector<float> input = std::vector<float>(kChannels * kChunk);
+        std::vector<float> wet = std::vector<float>(kChannels * kChunk);
+        std::vector<float> noise = std::vector<float>(kChannels * kChunk);
+        std::vector<float> fadeRead = std::vector<float>(kChannels * kChunk);
+        std::vector<float> tapOutput = std::vector<float>(kChannels * kChunk);
+        std::vector<float> tapSend = std::vector<float>(kChannels * kChunk);
+        std::vector<float> fadeGains = std::vector<float>(kChunk);
+        std::vector<float> delays = std::vector<float>(kChunk);
+        const float* inputs[kChannels] {};
+        float* wets[kChannels] {};
+        const float* noises[kChannels] {};
+        const float* fadeReads[kChannels] {};
+        const float* tapOutputs[kChannels] {};
+        const float* tapSends[kChannels] {};
+        // One tap a sample behind the write head and one fractional, ramping and sending.
+        MultiTap::NearTap nearTaps[2] { { 1, 0.0f, { 0.7f, 0.3f }, 0.5f, 0.0f, 0.0f, 0.0f },
+                                        { 13, 0.25f, { 0.2f, 0.45f }, 0.1f, 0.002f, 0.3f, -0.001f } };
+    };
+}
+
+TEST_CASE("DelayKernel dispatch covers every flag combination", "[delaykernel]")
+{
+    for (int index = 0; index < DelayKernel::numVariants; ++index)
+    {
+        const auto flags = makeFlags(index);
+        REQUIRE(DelayKernel::getIndex(flags) == index);
+        REQUIRE(DelayKernel::select(flags) != nullptr);
+
+        for (int other = 0; other < index; ++other)
+            REQUIRE(DelayKernel::select(flags) != DelayKernel::select(makeFlags(other)));
+    }
+}
+
+TEST_CASE("DelayKernel specialisations match the generic loop", "[delaykernel]")
+{
+    for (int index = 0; index < DelayKernel::numVariants; ++index)
+    {
+        const auto flags = makeFlags(index);
+        INFO(describe(flags));
+
+        Rig generic(flags);
+        Rig fixed(flags);
+        DelayKernel::Spread genericSpread;
+        DelayKernel::Spread fixedSpread;
+
+        // Several chunks, so the write head wraps and reads see freshly written samples.
+        for (int chunk = 0; chunk < 3; ++chunk)
+        {
+            DelayKernel::processGeneric(generic.makeBlock(), flags, generic.memory, generic.degrade, 0.8f,
+                                        genericSpread);
+            DelayKernel::select(flags)(fixed.makeBlock(), fixed.memory, fixed.degrade, 0.8f, fixedSpread);
+
+            REQUIRE(generic.memory.getWriteIndex() == fixed.memory.getWriteIndex());
+            for (size_t i = 0; i < generic.wet.size(); ++i)
+                REQUIRE(approxEqual(generic.wet[i], fixed.wet[i]));
+        }
+
+        for (int c = 0; c < kChannels; ++c)
+        {
+            for (int i = 0; i < generic.memory.getSize(); ++i)
+                REQUIRE(approxEqual(generic.memory.readSample(c, i), fixed.memory.readSample(c, i)));
+
+            REQUIRE(approxEqual(genericSpread.getRange(c), fixedSpread.getRange(c)));
+        }
+    }
+}
+
+TEST_CASE("DelayKernel nearest reads wrap like MemoryBuffer", "[delaykernel]")
+{
+    DelayKernel::Flags flags;
+    flags.authentic = true;
+    Rig rig(flags, 512);
+    rig.memory.setWriteIndex(3);
+    for (auto& delay : rig.delays)
+        delay = 700.5f;
+
+    const auto expected = rig.memory.readSample(1, static_cast<int>(3.0f - 700.5f));
+    DelayKernel::Spread spread;
+    DelayKernel::select(flags)(rig.makeBlock(), rig.memory, rig.degrade, 0.0f, spread);
+
+    REQUIRE(rig.wet[static_cast<size_t>(kChunk)] == expected);
+    REQUIRE(rig.memory.getWriteIndex() == 3 + kChunk);
+}
+
+TEST_CASE("DelayKernel reads taps closer than the chunk from what it has just written", "[delaykernel]")
+{
+    // Taps 37 and 1 samples behind the write head in full chunks: every tap sample is the input
+    // written exactly that many samples earlier. The main head sits out of reach of the input.
+    MemoryBuffer memory;
+    memory.prepare(1, 8192);
+    FeedbackModel degrade;
+    degrade.reset(48000.0);
+    degrade.setParameters(0.4f, 0.0f);
+
+    MultiTap taps;
+    taps.prepare(kChunk);
+    taps.setNumTaps(2);
+    taps.setTap(0, { 37.0f, 1.0f, 0.0f, 0.0f });
+    taps.setTap(1, { 1.0f, 0.5f, 0.0f, 0.0f });
+
+    std::vector<float> input(kChunk);
+    std::vector<float> wet(kChunk);
+    std::vector<float> tapOutput(kChunk);
+    std::vector<float> tapSend(kChunk);
+    std::vector<float> delays(kChunk, 8000.0f);
+    const float* inputs[] = { input.data() };
+    float* wets[] = { wet.data() };
+    const float* tapOutputs[] = { tapOutput.data() };
+    const float* tapSends[] = { tapSend.data() };
+    float* tapOutputBlocks[] = { tapOutput.data() };
+    float* tapSendBlocks[] = { tapSend.data() };
+
+    const auto inputAt = [](int time) { return time < 0 ? 0.0f : static_cast<float>(time % 1000 + 1); };
+    const auto kernel = DelayKernel::select({ false, false, false, true, false });
+    for (int chunk = 0; chunk < 20; ++chunk)
+    {
+        for (int i = 0; i < kChunk; ++i)
+            input[static_cast<size_t>(i)] = inputAt(chunk * kChunk + i);
+
+        taps.process(memory, memory.getWriteIndex(), tapOutputBlocks, tapSendBlocks, 1, kChunk);
+        REQUIRE(taps.getNumNearTaps() == 2);
+
+        DelayKernel::Spread spread;
+        kernel({ inputs, wets, nullptr, nullptr, nullptr, tapOutputs, tapSends, delays.data(), 1, kChunk,
+                 taps.getNearTaps(), taps.getNumNearTaps() },
+               memory, degrade, 0.0f, spread);
+
+        // The first chunk ramps the tap gains in.
+        for (int i = 0; chunk > 0 && i < kChunk; ++i)
+        {
+            const auto time = chunk * kChunk + i;
+            REQUIRE(wet[static_cast<size_t>(i)] == inputAt(time - 37) + 0.5f * inputAt(time - 1));
+        }
+    }
+}
+
+TEST_CASE("DelayKernel specialisations against the generic loop", "[.][benchmark][delaykernel]")
+{
+    for (int index = 0; index < DelayKernel::numVariants; ++index)
+    {
+        const auto flags = makeFlags(index);
+        const auto name = describe(flags);
+        Rig generic(flags, 48000 * 4);
+        Rig fixed(flags, 48000 * 4);
+        const auto genericBlock = generic.makeBlock();
+        const auto fixedBlock = fixed.makeBlock();
+        const auto kernel = DelayKernel::select(flags);
+
+        BENCHMARK("generic " + name)
+        {
+            DelayKernel::Spread spread;
+            DelayKernel::processGeneric(genericBlock, flags, generic.memory, generic.degrade, 0.8f, spread);
+            return spread.getRange(0);
+        };
+
+        BENCHMARK("specialised " + name)
+        {
+            DelayKernel::Spread spread;
+            kernel(fixedBlock, fixed.memory, fixed.degrade, 0.8f, spread);
+            return spread.getRange(0);
+        };
+    }
+}
+
+TEST_CASE("DelayKernel loop at the default grit decays to exact silence", "[delaykernel]")
+{
+    // Default engine settings: filter 0.6, grit 0.25, feedback 0.65. After the input stops, the
+    // recirculating signal and its grit must die out completely, not settle into a limit cycle.
+    constexpr int kDelay = 2000;
+    MemoryBuffer memory;
+    memory.prepare(kChannels, 4096);
+    FeedbackModel degrade;
+    degrade.reset(48000.0);
+
+    std::vector<float> input(static_cast<size_t>(kChannels * kChunk));
+    std::vector<float> wet(input.size());
+    std::vector<float> noise(input.size());
+    std::vector<float> delays(static_cast<size_t>(kChunk), static_cast<float>(kDelay));
+    const float* inputs[] = { input.data(), input.data() + kChunk };
+    float* wets[] = { wet.data(), wet.data() + kChunk };
+    const float* noises[] = { noise.data(), noise.data() + kChunk };
+
+    DelayKernel::Spread spread;
+    for (int chunk = 0; chunk < 2000; ++chunk)
+    {
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            const auto time = chunk * kChunk + static_cast<int>(i % kChunk);
+            input[i] = time < kDelay ? 0.5f * std::sin(0.05f * static_cast<float>(time)) : 0.0f;
+            noise[i] = static_cast<float>((time * 7919 + static_cast<int>(i / kChunk) * 104729) % 1009) / 1008.0f;
+        }
+
+        degrade.setParameters({ 0.6f }, 0.25f, kChunk);
+        spread = {};
+        DelayKernel::select({ false, true, false, false, false })(
+            { inputs, wets, noises, nullptr, nullptr, nullptr, nullptr, delays.data(), kChannels, kChunk },
+            memory, degrade, 0.65f, spread);
+    }
+
+    REQUIRE(spread.getRange(0) == 0.0f);
+    REQUIRE(spread.getRange(1) == 0.0f);
+    for (const auto value : wet)
+        REQUIRE(value == 0.0f);
+}
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "dsp/EngineStatus.h"
+
+TEST_CASE("EngineStatusChannel returns the last published status", "[status]")
+{
+    EngineStatusChannel channel;
+    EngineStatus status;
+    REQUIRE(channel.read(status));
+    REQUIRE(status.state == LoopState::Idle);
+    REQUIRE(status.loopLength == 0);
+
+    EngineStatus published;
+    published.state = LoopState::Overdub;
+    published.clip = true;
+    published.meterL = 0.5f;
+    published.meterR = 0.25f;
+    published.sampleRate = 48000.0;
+    published.playhead = 1200.0;
+    published.loopLength = 4800;
+    published.recordedSamples = 4800;
+    published.capacitySamples = 9600;
+    published.processedSamples = 123456789;
+    published.reverse = true;
+    channel.publish(published);
+
+    REQUIRE(channel.read(status));
+    REQUIRE(status.state == LoopState::Overdub);
+    REQUIRE(status.clip);
+    REQUIRE_FALSE(status.sleeping);
+    REQUIRE(status.reverse);
+    REQUIRE_FALSE(status.halfSpeed);
+    REQUIRE(status.meterL == 0.5f);
+    REQUIRE(status.meterR == 0.25f);
+    REQUIRE(status.playhead == 1200.0);
+    REQUIRE(status.loopLength == 4800);
+    REQUIRE(status.processedSamples == 123456789);
+    REQUIRE(status.getRecordProgress() == 0.5f);
+    REQUIRE(status.getLoopProgress() == 0.25f);
+}
+
+TEST_CASE("EngineStatus progress is zero without a loop or buffer", "[status]")
+{
+    EngineStatus status;
+    status.playhead = 100.0;
+    REQUIRE(status.getLoopProgress() == 0.0f);
+    REQUIRE(status.getRecordProgress() == 0.0f);
+}
+
+TEST_CASE("EngineStatusChannel never returns a torn snapshot", "[status]")
+{
+    EngineStatusChannel channel;
+    std::atomic<bool> running { true };
+
+    // Every field is derived from one counter, so a mix of two publishes is detectable.
+    std::thread writer([&]
+                       {
+                           for (std::uint64_t n = 1; running.load(); ++n)
+                           {
+                               EngineStatus status;
+                               status.processedSamples = n;
+                               status.recordedSamples = static_cast<int>(n & 0xffffff);
+                               status.loopLength = static_cast<int>((n * 3) & 0xffffff);
+                               status.playhead = static_cast<double>(n) * 0.5;
+                               status.meterL = static_cast<float>(n & 0xff);
+                               channel.publish(status);
+                           }
+                       });
+
+    int consistent = 0;
+    int torn = 0;
+    std::uint64_t last = 0;
+    bool ordered = true;
+    for (int i = 0; i < 200000; ++i)
+    {
+        EngineStatus status;
+        if (!channel.read(status))
+            continue;
+
+        const auto n = status.processedSamples;
+        const auto matches = status.recordedSamples == static_cast<int>(n & 0xffffff)
+                             && status.loopLength == static_cast<int>((n * 3) & 0xffffff)
+                             && status.playhead == static_cast<double>(n) * 0.5
+                             && status.meterL == static_cast<float>(n & 0xff);
+        (matches ? consistent : torn) += 1;
+        ordered = ordered && n >= last;
+        last = n;
+    }
+
+    running.store(false);
+    writer.join();
+
+    REQUIRE(torn == 0);
+    REQUIRE(consistent > 0);
+    REQUIRE(ordered);
+}
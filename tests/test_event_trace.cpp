@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "dsp/EventTrace.h"
+
+TEST_CASE("EventTrace reads events in order", "[trace]")
+{
+    EventTrace trace;
+    trace.push(10, TraceEvent::Type::StateChange, 1, 0.0f, 1.0f);
+    trace.push(20, TraceEvent::Type::Parameter, 3, 0.5f, 0.7f);
+
+    std::vector<TraceEvent> events(8);
+    REQUIRE(trace.read(events.data(), 8) == 2);
+    REQUIRE(events[0].sampleTime == 10);
+    REQUIRE(events[0].type == TraceEvent::Type::StateChange);
+    REQUIRE(events[1].id == 3);
+    REQUIRE(events[1].current == 0.7f);
+
+    REQUIRE(trace.read(events.data(), 8) == 0);
+}
+
+TEST_CASE("EventTrace overwrites oldest events and counts drops", "[trace]")
+{
+    EventTrace trace;
+    const auto total = EventTrace::capacity + 100;
+    for (int i = 0; i < total; ++i)
+        trace.push(static_cast<std::uint64_t>(i), TraceEvent::Type::Parameter, 0, 0.0f, 0.0f);
+
+    std::vector<TraceEvent> events(EventTrace::capacity);
+    const auto count = trace.read(events.data(), EventTrace::capacity);
+    REQUIRE(count == EventTrace::capacity);
+    REQUIRE(events[0].sampleTime == 100);
+    REQUIRE(trace.getDroppedCount() == 100);
+
+    REQUIRE(trace.copyRecent(events.data(), 4) == 4);
+    REQUIRE(events[3].sampleTime == static_cast<std::uint64_t>(total - 1));
+}
+
+TEST_CASE("EventTrace reader sees monotonic timestamps under concurrent writes", "[trace]")
+{
+    EventTrace trace;
+    constexpr int total = 200000;
+
+    std::thread writer([&trace]
+    {
+        for (int i = 0; i < total; ++i)
+            trace.push(static_cast<std::uint64_t>(i), TraceEvent::Type::Parameter, 0, 0.0f, 0.0f);
+    });
+
+    std::vector<TraceEvent> events(64);
+    std::uint64_t last = 0;
+    bool ordered = true;
+    bool first = true;
+    auto drain = [&]
+    {
+        const auto count = trace.read(events.data(), 64);
+        for (int i = 0; i < count; ++i)
+        {
+            if (!first && events[static_cast<size_t>(i)].sampleTime <= last)
+                ordered = false;
+            last = events[static_cast<size_t>(i)].sampleTime;
+            first = false;
+        }
+        return count;
+    };
+
+    while (trace.getWriteCount() < static_cast<std::uint64_t>(total))
+        drain();
+
+    writer.join();
+    while (drain() > 0)
+    {
+    }
+
+    REQUIRE(ordered);
+    REQUIRE(last == static_cast<std::uint64_t>(total - 1));
+}
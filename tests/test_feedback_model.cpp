@@ -12,7 +12,134 @@ TEST_CASE("FeedbackModel outputs finite values", "[feedback]")
     float value = 0.5f;
     for (int i = 0; i < 512; ++i)
     {
-        value = model.process(value, 0.5f, 0.5f, 1.1f, 0.5f);
+        value = model.process(0, value, 0.5f, 0.5f, 1.1f, 0.5f);
         REQUIRE(std::isfinite(value));
     }
 }
+
+TEST_CASE("FeedbackModel block form matches per-sample processing", "[feedback]")
+{
+    constexpr int numSamples = 64;
+    float left[numSamples];
+    float right[numSamples];
+    float randomL[numSamples];
+    float randomR[numSamples];
+    float expectedL[numSamples];
+    float expectedR[numSamples];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        left[i] = 1.5f * std::sin(0.21f * static_cast<float>(i));
+        right[i] = 0.8f * std::cos(0.13f * static_cast<float>(i));
+        randomL[i] = static_cast<float>((i * 13) % 17) / 17.0f;
+        randomR[i] = static_cast<float>((i * 5) % 11) / 11.0f;
+    }
+
+    FeedbackModel reference;
+    reference.reset(44100.0);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        expectedL[i] = reference.process(0, left[i], 0.3f, 0.4f, 0.9f, randomL[i]);
+        expectedR[i] = reference.process(1, right[i], 0.3f, 0.4f, 0.9f, randomR[i]);
+    }
+
+    FeedbackModel model;
+    model.reset(44100.0);
+    model.setParameters(0.3f, 0.4f);
+    float* channels[] = { left, right };
+    const float* random[] = { randomL, randomR };
+    model.processBlock(channels, random, 2, numSamples, 0.9f);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        REQUIRE(left[i] == expectedL[i]);
+        REQUIRE(right[i] == expectedR[i]);
+    }
+}
+
+TEST_CASE("FeedbackModel filters each channel with its own state", "[feedback]")
+{
+    constexpr int numSamples = 128;
+    float left[numSamples];
+    float right[numSamples];
+    float alone[numSamples];
+    float random[numSamples] {};
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        left[i] = i % 16 == 0 ? 1.0f : -0.2f;
+        right[i] = 0.4f * std::sin(0.07f * static_cast<float>(i));
+        alone[i] = right[i];
+    }
+
+    const FeedbackModel::Tone tone { 0.2f, 0.8f, StateVariableFilter::Mode::Bandpass };
+
+    FeedbackModel stereo;
+    stereo.reset(48000.0);
+    stereo.setParameters(tone, 0.0f, numSamples);
+    float* channels[] = { left, right };
+    const float* randoms[] = { random, random };
+    stereo.processBlock(channels, randoms, 2, numSamples, 1.0f);
+
+    FeedbackModel mono;
+    mono.reset(48000.0);
+    mono.setParameters(tone, 0.0f, numSamples);
+    float* monoChannels[] = { alone };
+    mono.processBlock(monoChannels, randoms, 1, numSamples, 1.0f);
+
+    for (int i = 0; i < numSamples; ++i)
+        REQUIRE(right[i] == alone[i]);
+}
+
+TEST_CASE("FeedbackModel frame form matches per-sample processing", "[feedback]")
+{
+    const FeedbackModel::Tone tone { 0.5f, 0.5f, StateVariableFilter::Mode::Highpass };
+
+    FeedbackModel reference;
+    reference.reset(44100.0);
+    reference.setParameters(tone, 0.3f, 64);
+
+    FeedbackModel model;
+    model.reset(44100.0);
+    model.setParameters(tone, 0.3f, 64);
+
+    for (int i = 0; i < 256; ++i)
+    {
+        FeedbackModel::Frame frame { std::sin(0.1f * static_cast<float>(i)), 0.7f * std::cos(0.3f * static_cast<float>(i)) };
+        const FeedbackModel::Frame random { static_cast<float>(i % 7) / 7.0f, static_cast<float>(i % 5) / 5.0f };
+        const auto expectedL = reference.processSample(0, frame[0], 0.8f, random[0]);
+        const auto expectedR = reference.processSample(1, frame[1], 0.8f, random[1]);
+
+        model.processFrame(frame, random, 2, 0.8f);
+        REQUIRE(frame[0] == expectedL);
+        REQUIRE(frame[1] == expectedR);
+    }
+}
+
+TEST_CASE("FeedbackModel quantizes values near zero to silence and adds no grit to them", "[feedback]")
+{
+    FeedbackModel model;
+    model.reset(48000.0);
+    // 0.25 grit gives 192 levels: an odd number of steps, so no level sits at zero.
+    model.setParameters(1.0f, 0.25f);
+
+    const auto halfStep = 1.0f / 191.0f;
+    for (const auto random : { 0.0f, 0.3f, 1.0f })
+    {
+        REQUIRE(model.processSample(0, 0.0f, 0.65f, random) == 0.0f);
+        model.reset(48000.0);
+        model.setParameters(1.0f, 0.25f);
+        REQUIRE(model.processSample(0, 0.8f * halfStep, 0.65f, random) == 0.0f);
+        model.reset(48000.0);
+        model.setParameters(1.0f, 0.25f);
+    }
+
+    // Above the dead zone the grit is there.
+    FeedbackModel low;
+    low.reset(48000.0);
+    low.setParameters(1.0f, 0.25f);
+    FeedbackModel high;
+    high.reset(48000.0);
+    high.setParameters(1.0f, 0.25f);
+    REQUIRE(low.processSample(0, 0.5f, 1.0f, 0.0f) != high.processSample(0, 0.5f, 1.0f, 1.0f));
+}
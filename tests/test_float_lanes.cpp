@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <limits>
+
+#include "dsp/FloatLanes.h"
+
+namespace
+{
+    const FloatLanes::Array kA { 1.5f, -2.25f, 0.0f, 3.0e-3f };
+    const FloatLanes::Array kB { -0.5f, 4.0f, -0.0f, 7.0f };
+}
+
+TEST_CASE("FloatLanes arithmetic matches the scalar operation per lane", "[lanes]")
+{
+    const auto a = FloatLanes::fromArray(kA);
+    const auto b = FloatLanes::fromArray(kB);
+
+    const auto sum = (a + b).toArray();
+    const auto difference = (a - b).toArray();
+    const auto product = (a * b).toArray();
+    const auto quotient = (a / b).toArray();
+    const auto smaller = FloatLanes::min(a, b).toArray();
+    const auto larger = FloatLanes::max(a, b).toArray();
+    const auto magnitude = FloatLanes::abs(b).toArray();
+    const auto chosen = FloatLanes::selectGreater(a, b, FloatLanes::expand(1.0f), FloatLanes::expand(2.0f)).toArray();
+
+    for (size_t lane = 0; lane < static_cast<size_t>(FloatLanes::size); ++lane)
+    {
+        REQUIRE(sum[lane] == kA[lane] + kB[lane]);
+        REQUIRE(difference[lane] == kA[lane] - kB[lane]);
+        REQUIRE(product[lane] == kA[lane] * kB[lane]);
+        if (kB[lane] != 0.0f)
+            REQUIRE(quotient[lane] == kA[lane] / kB[lane]);
+        REQUIRE(smaller[lane] == (kA[lane] < kB[lane] ? kA[lane] : kB[lane]));
+        REQUIRE(larger[lane] == (kA[lane] > kB[lane] ? kA[lane] : kB[lane]));
+        REQUIRE(magnitude[lane] == std::abs(kB[lane]));
+        REQUIRE_FALSE(std::signbit(magnitude[lane]));
+        REQUIRE(chosen[lane] == (kA[lane] > kB[lane] ? 1.0f : 2.0f));
+    }
+
+    auto accumulated = a;
+    accumulated += b;
+    accumulated *= FloatLanes::expand(2.0f);
+    accumulated -= a;
+    const auto result = accumulated.toArray();
+    for (size_t lane = 0; lane < static_cast<size_t>(FloatLanes::size); ++lane)
+        REQUIRE(result[lane] == (kA[lane] + kB[lane]) * 2.0f - kA[lane]);
+}
+
+TEST_CASE("FloatLanes loads, stores and expands", "[lanes]")
+{
+    REQUIRE(FloatLanes().toArray() == FloatLanes::Array {});
+    REQUIRE(FloatLanes::expand(0.75f).toArray() == FloatLanes::Array { 0.75f, 0.75f, 0.75f, 0.75f });
+
+    // Any alignment.
+    float buffer[FloatLanes::size + 1] { 9.0f, 1.0f, 2.0f, 3.0f, 4.0f };
+    const auto loaded = FloatLanes::load(buffer + 1);
+    REQUIRE(loaded.toArray() == FloatLanes::Array { 1.0f, 2.0f, 3.0f, 4.0f });
+
+    (loaded * FloatLanes::expand(-1.0f)).store(buffer);
+    REQUIRE(buffer[0] == -1.0f);
+    REQUIRE(buffer[3] == -4.0f);
+    REQUIRE(buffer[4] == 4.0f);
+}
+
+TEST_CASE("FloatLanes min and max return the second operand for NaN lanes", "[lanes]")
+{
+    const auto nan = std::numeric_limits<float>::quiet_NaN();
+    const auto a = FloatLanes::fromArray({ nan, 1.0f, nan, 0.0f });
+    const auto b = FloatLanes::fromArray({ 2.0f, nan, 3.0f, 5.0f });
+
+    const auto smaller = FloatLanes::min(a, b).toArray();
+    const auto larger = FloatLanes::max(a, b).toArray();
+    REQUIRE(smaller[0] == 2.0f);
+    REQUIRE(std::isnan(smaller[1]));
+    REQUIRE(larger[2] == 3.0f);
+    REQUIRE(larger[3] == 5.0f);
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <cmath>
+
 #include "dsp/Limiter.h"
 
 TEST_CASE("Limiter clamps peaks above threshold", "[limiter]")
@@ -17,3 +19,47 @@ TEST_CASE("Limiter clamps peaks above threshold", "[limiter]")
 
     REQUIRE(output <= 0.5f + 1.0e-3f);
 }
+
+TEST_CASE("Limiter limits every lane against its own envelope", "[limiter]")
+{
+    Limiter packed;
+    packed.reset(48000.0);
+    packed.setThreshold(0.5f);
+
+    Limiter left;
+    left.reset(48000.0);
+    left.setThreshold(0.5f);
+
+    Limiter right;
+    right.reset(48000.0);
+    right.setThreshold(0.5f);
+
+    for (int i = 0; i < 2048; ++i)
+    {
+        // A loud left channel must not pull the quiet right one down.
+        const auto loud = (i % 64 < 32 ? 1.0f : -1.0f) * 0.9f;
+        const auto quiet = 0.2f * std::sin(0.01f * static_cast<float>(i));
+        const auto frame = packed.process(FloatLanes::fromArray({ loud, quiet, 0.0f, 0.0f })).toArray();
+
+        REQUIRE(std::abs(frame[0] - left.process(loud)) < 1.0e-6f);
+        REQUIRE(std::abs(frame[1] - right.process(quiet)) < 1.0e-6f);
+        REQUIRE(frame[1] == quiet);
+        REQUIRE(frame[2] == 0.0f);
+    }
+}
+
+TEST_CASE("Limiter single-channel form leaves the other lanes alone", "[limiter]")
+{
+    Limiter limiter;
+    limiter.reset(48000.0);
+    limiter.setThreshold(0.5f);
+
+    // Lane 1 builds up an envelope; lane-0-only calls must not disturb it.
+    for (int i = 0; i < 256; ++i)
+        limiter.process(FloatLanes::fromArray({ 0.0f, 1.0f, 0.0f, 0.0f }));
+    for (int i = 0; i < 256; ++i)
+        limiter.process(0.1f);
+
+    const auto frame = limiter.process(FloatLanes::fromArray({ 0.0f, 1.0f, 0.0f, 0.0f })).toArray();
+    REQUIRE(frame[1] < 0.6f);
+}
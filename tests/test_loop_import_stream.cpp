@@ -0,0 +1,111 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "dsp/LoopImportStream.h"
+
+namespace
+{
+    constexpr int kPage = LoopImportStream::pageSize;
+
+    float valueAt(int channel, int frame)
+    {
+        return static_cast<float>(frame % 10007) / 10007.0f - static_cast<float>(channel);
+    }
+}
+
+TEST_CASE("LoopImportStream hands pages over in order and fills up", "[import]")
+{
+    LoopImportStream stream;
+    REQUIRE(stream.begin(2, kPage * 20, 48000.0));
+    REQUIRE_FALSE(stream.begin(2, kPage, 48000.0));
+    REQUIRE(stream.getState() == LoopImportStream::State::Streaming);
+
+    int frames = 0;
+    REQUIRE(stream.peek(frames) == nullptr);
+
+    for (int page = 0; page < LoopImportStream::numSlots; ++page)
+    {
+        auto* slot = stream.acquire();
+        REQUIRE(slot != nullptr);
+        slot[0] = static_cast<float>(page);
+        slot[kPage] = -static_cast<float>(page);
+        stream.publish(kPage - page);
+    }
+
+    // Full until the consumer returns a slot.
+    REQUIRE(stream.acquire() == nullptr);
+
+    const auto* page = stream.peek(frames);
+    REQUIRE(page != nullptr);
+    REQUIRE(frames == kPage);
+    REQUIRE(page[0] == 0.0f);
+    stream.pop();
+    REQUIRE(stream.acquire() != nullptr);
+
+    page = stream.peek(frames);
+    REQUIRE(frames == kPage - 1);
+    REQUIRE(page[kPage] == -1.0f);
+
+    stream.cancel();
+    REQUIRE(stream.getState() == LoopImportStream::State::Cancelled);
+    stream.close();
+    REQUIRE(stream.getState() == LoopImportStream::State::Idle);
+}
+
+TEST_CASE("LoopImportStream streams a loop into memory across threads", "[import]")
+{
+    constexpr int total = kPage * 40 + 123;
+    LoopImportStream stream;
+    REQUIRE(stream.begin(2, total, 44100.0));
+
+    std::thread producer([&stream]
+                         {
+                             for (int offset = 0; offset < total; offset += kPage)
+                             {
+                                 float* slot = nullptr;
+                                 while ((slot = stream.acquire()) == nullptr)
+                                     std::this_thread::yield();
+
+                                 const auto frames = std::min(kPage, total - offset);
+                                 for (int c = 0; c < 2; ++c)
+                                     for (int i = 0; i < frames; ++i)
+                                         slot[c * kPage + i] = valueAt(c, offset + i);
+                                 stream.publish(frames);
+                             }
+                         });
+
+    MemoryBuffer memory;
+    memory.prepare(2, total + 1000);
+    int written = 0;
+    while (written < total)
+    {
+        int frames = 0;
+        const auto* page = stream.peek(frames);
+        if (page == nullptr)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        for (int c = 0; c < 2; ++c)
+            memory.writeBlock(c, written, page + c * kPage, frames);
+        stream.pop();
+        written += frames;
+    }
+
+    stream.complete();
+    producer.join();
+    REQUIRE(written == total);
+
+    bool intact = true;
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < total; ++i)
+            intact = intact && memory.readSample(c, i) == valueAt(c, i);
+    REQUIRE(intact);
+
+    REQUIRE(stream.getState() == LoopImportStream::State::Complete);
+    stream.close();
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "dsp/LoopResampler.h"
+
+TEST_CASE("LoopResampler sinc reproduces samples at integer positions", "[resampler]")
+{
+    std::vector<float> data(64);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = std::sin(static_cast<float>(i) * 0.37f);
+
+    LoopResampler resampler;
+    resampler.prepare();
+
+    const LoopView loop { data.data(), 64, 0, 64 };
+    std::vector<int> indices(64);
+    std::vector<float> fractions(64, 0.0f);
+    std::vector<float> out(64);
+    for (int i = 0; i < 64; ++i)
+        indices[static_cast<size_t>(i)] = i;
+
+    resampler.process(loop, indices.data(), fractions.data(), out.data(), 64, LoopResampler::Quality::Sinc, 1.0);
+
+    for (size_t i = 0; i < out.size(); ++i)
+        REQUIRE(std::abs(out[i] - data[i]) < 1.0e-5f);
+}
+
+TEST_CASE("LoopResampler interpolates a slow sine at fractional positions", "[resampler]")
+{
+    constexpr int size = 512;
+    constexpr float w = 0.05f;
+    std::vector<float> data(size);
+    for (int i = 0; i < size; ++i)
+        data[static_cast<size_t>(i)] = std::sin(static_cast<float>(i) * w);
+
+    LoopResampler resampler;
+    resampler.prepare();
+
+    const LoopView loop { data.data(), size, 0, size };
+    int index = 200;
+    float fraction = 0.37f;
+    float linear = 0.0f;
+    float sinc = 0.0f;
+    resampler.process(loop, &index, &fraction, &linear, 1, LoopResampler::Quality::Linear, 0.5);
+    resampler.process(loop, &index, &fraction, &sinc, 1, LoopResampler::Quality::Sinc, 0.5);
+
+    const auto expected = std::sin((200.0f + 0.37f) * w);
+    REQUIRE(std::abs(sinc - expected) < 1.0e-3f);
+    REQUIRE(std::abs(sinc - expected) < std::abs(linear - expected));
+}
+
+TEST_CASE("LoopResampler wraps taps around the loop and buffer ends", "[resampler]")
+{
+    // Buffer of 16 with a loop of 10 starting at 12, so the loop crosses the buffer end.
+    std::vector<float> data(16, -1.0f);
+    for (int i = 0; i < 10; ++i)
+        data[static_cast<size_t>((12 + i) % 16)] = static_cast<float>(i);
+
+    const LoopView loop { data.data(), 16, 12, 10 };
+    REQUIRE(LoopResampler::readLoop(loop, 0) == 0.0f);
+    REQUIRE(LoopResampler::readLoop(loop, 9) == 9.0f);
+    REQUIRE(LoopResampler::readLoop(loop, 10) == 0.0f);
+    REQUIRE(LoopResampler::readLoop(loop, -1) == 9.0f);
+
+    LoopResampler resampler;
+    int index = 9;
+    float fraction = 0.5f;
+    float out = 0.0f;
+    resampler.process(loop, &index, &fraction, &out, 1, LoopResampler::Quality::Linear, -1.0);
+    REQUIRE(out == 4.5f);
+
+    std::vector<float> constant(16, 0.25f);
+    const LoopView flat { constant.data(), 16, 12, 10 };
+    resampler.prepare();
+    for (int i = 0; i < 10; ++i)
+    {
+        float value = 0.0f;
+        float frac = 0.3f;
+        resampler.process(flat, &i, &frac, &value, 1, LoopResampler::Quality::Sinc, 2.0);
+        REQUIRE(std::abs(value - 0.25f) < 1.0e-5f);
+    }
+}
+
+TEST_CASE("LoopResampler reads integer storage like the equivalent float data", "[resampler]")
+{
+    const auto codec = SampleCodec::forFormat(SampleFormat::Int16);
+    std::vector<std::int16_t> words(48);
+    std::vector<float> data(48);
+    for (size_t i = 0; i < words.size(); ++i)
+    {
+        words[i] = codec.pack(0.8f * std::sin(static_cast<float>(i) * 0.3f));
+        data[i] = codec.unpack(words[i]);
+    }
+
+    LoopResampler resampler;
+    resampler.prepare();
+
+    const LoopView floatLoop { data.data(), 48, 40, 24 };
+    const LoopView packedLoop { nullptr, 48, 40, 24, words.data(), codec };
+    std::vector<int> indices(30);
+    std::vector<float> fractions(30);
+    for (int i = 0; i < 30; ++i)
+    {
+        indices[static_cast<size_t>(i)] = i;
+        fractions[static_cast<size_t>(i)] = 0.3f;
+    }
+
+    for (const auto quality : { LoopResampler::Quality::Nearest, LoopResampler::Quality::Linear,
+                                LoopResampler::Quality::Sinc })
+    {
+        std::vector<float> expected(30);
+        std::vector<float> out(30);
+        resampler.process(floatLoop, indices.data(), fractions.data(), expected.data(), 30, quality, 1.0);
+        resampler.process(packedLoop, indices.data(), fractions.data(), out.data(), 30, quality, 1.0);
+        for (size_t i = 0; i < out.size(); ++i)
+            REQUIRE(out[i] == expected[i]);
+    }
+}
@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "dsp/LoopSnapshot.h"
+
+namespace
+{
+    constexpr int kPage = LoopSnapshot::pageSize;
+
+    MemoryBuffer makeRamp(int channels, int size)
+    {
+        MemoryBuffer buffer;
+        buffer.prepare(channels, size);
+        for (int c = 0; c < channels; ++c)
+            for (int i = 0; i < size; ++i)
+                buffer.writeSample(c, i, static_cast<float>(i % 8192) / 8192.0f - static_cast<float>(c));
+        return buffer;
+    }
+
+    bool matches(const LoopSnapshot& snapshot, const std::vector<std::vector<float>>& expected)
+    {
+        for (size_t c = 0; c < expected.size(); ++c)
+            for (size_t i = 0; i < expected[c].size(); ++i)
+                if (snapshot.getChannel(static_cast<int>(c))[i] != expected[c][i])
+                    return false;
+        return true;
+    }
+
+    std::vector<std::vector<float>> copyLoop(const MemoryBuffer& buffer, int start, int length)
+    {
+        std::vector<std::vector<float>> loop(static_cast<size_t>(buffer.getNumChannels()),
+                                             std::vector<float>(static_cast<size_t>(length)));
+        for (int c = 0; c < buffer.getNumChannels(); ++c)
+            buffer.readBlock(c, start, loop[static_cast<size_t>(c)].data(), length);
+        return loop;
+    }
+}
+
+TEST_CASE("LoopSnapshot copies the loop a few pages per block", "[snapshot]")
+{
+    auto memory = makeRamp(2, kPage * 8);
+    const auto expected = copyLoop(memory, kPage * 6, kPage * 3 + 100);
+
+    LoopSnapshot snapshot;
+    REQUIRE(snapshot.request(2, kPage * 8));
+    REQUIRE_FALSE(snapshot.request(2, kPage * 8));
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Requested);
+
+    // The loop wraps the end of the buffer; four pages go in two steps.
+    snapshot.advance(memory, kPage * 6, kPage * 3 + 100, 48000.0, 2);
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Copying);
+    snapshot.advance(memory, 0, 0, 0.0, 2);
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Complete);
+
+    REQUIRE(snapshot.getLength() == kPage * 3 + 100);
+    REQUIRE(snapshot.getSampleRate() == 48000.0);
+    REQUIRE(matches(snapshot, expected));
+
+    snapshot.release();
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Idle);
+}
+
+TEST_CASE("LoopSnapshot keeps the frozen loop while it is being overwritten", "[snapshot]")
+{
+    auto memory = makeRamp(2, kPage * 4);
+    const auto loopStart = 1000;
+    const auto loopLength = kPage * 3;
+    const auto expected = copyLoop(memory, loopStart, loopLength);
+
+    LoopSnapshot snapshot;
+    REQUIRE(snapshot.request(2, kPage * 4));
+    snapshot.advance(memory, loopStart, loopLength, 44100.0, 0);
+
+    // Overdub-style writes all over the loop, each announced before it lands.
+    const std::vector<float> junk(300, 0.75f);
+    for (int write = 0; write < 40; ++write)
+    {
+        const auto start = (loopStart + write * 977) % memory.getSize();
+        snapshot.protect(memory, start, 300);
+        for (int c = 0; c < 2; ++c)
+            memory.writeBlock(c, start, junk.data(), 300);
+
+        if (write % 10 == 9)
+            snapshot.advance(memory, 0, 0, 0.0, 1);
+    }
+
+    snapshot.advance(memory, 0, 0, 0.0, 16);
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Complete);
+    REQUIRE(matches(snapshot, expected));
+}
+
+TEST_CASE("LoopSnapshot finishes before a clear and fails without a loop", "[snapshot]")
+{
+    auto memory = makeRamp(1, kPage * 4);
+    const auto expected = copyLoop(memory, 0, kPage * 2);
+
+    LoopSnapshot snapshot;
+    REQUIRE(snapshot.request(1, kPage * 4));
+    snapshot.advance(memory, 0, kPage * 2, 48000.0, 0);
+    snapshot.finish(memory);
+    memory.clear();
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Complete);
+    REQUIRE(matches(snapshot, expected));
+    snapshot.release();
+
+    REQUIRE(snapshot.request(1, kPage * 4));
+    snapshot.advance(memory, 0, 0, 48000.0, 4);
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Failed);
+    snapshot.release();
+
+    // Larger than the room requested.
+    REQUIRE(snapshot.request(1, kPage));
+    snapshot.advance(memory, 0, kPage * 2, 48000.0, 4);
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Failed);
+    snapshot.release();
+
+    REQUIRE(snapshot.request(1, kPage * 4));
+    snapshot.advance(memory, 0, kPage * 2, 48000.0, 0);
+    snapshot.abandon();
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Abandoned);
+    snapshot.release();
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Idle);
+}
+
+TEST_CASE("LoopSnapshot can be cancelled when the audio thread stops calling", "[snapshot]")
+{
+    auto memory = makeRamp(1, kPage * 4);
+
+    LoopSnapshot snapshot;
+    const auto before = snapshot.getAdvanceCount();
+    REQUIRE(snapshot.request(1, kPage * 4));
+    snapshot.cancel();
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Abandoned);
+    // A late block does not pick the cancelled request back up.
+    snapshot.advance(memory, 0, kPage * 2, 48000.0, 4);
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Abandoned);
+    REQUIRE(snapshot.getAdvanceCount() == before + 1);
+    snapshot.release();
+
+    // Under way: the copy is only let go of at the next block.
+    REQUIRE(snapshot.request(1, kPage * 4));
+    snapshot.advance(memory, 0, kPage * 2, 48000.0, 1);
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Copying);
+    snapshot.cancel();
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Copying);
+    snapshot.advance(memory, 0, kPage * 2, 48000.0, 1);
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Abandoned);
+    REQUIRE(snapshot.getAdvanceCount() == before + 3);
+    snapshot.release();
+
+    // The next request is not affected.
+    const auto expected = copyLoop(memory, 0, kPage * 2);
+    REQUIRE(snapshot.request(1, kPage * 4));
+    snapshot.advance(memory, 0, kPage * 2, 48000.0, 4);
+    REQUIRE(snapshot.getState() == LoopSnapshot::State::Complete);
+    REQUIRE(matches(snapshot, expected));
+    snapshot.release();
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <cmath>
+
 #include "dsp/MemoryBuffer.h"
 
 TEST_CASE("MemoryBuffer wraps write index", "[buffer]")
@@ -30,3 +32,121 @@ TEST_CASE("MemoryBuffer reads and writes with wrap", "[buffer]")
     REQUIRE(buffer.readSample(0, 4) == 1.0f);
     REQUIRE(buffer.readSample(0, -1) == 4.0f);
 }
+
+TEST_CASE("MemoryBuffer clears whole pages around a span", "[buffer]")
+{
+    const auto size = MemoryBuffer::pageSize * 3;
+    MemoryBuffer buffer;
+    buffer.prepare(2, size);
+
+    for (int i = 0; i < size; ++i)
+    {
+        buffer.writeSample(0, i, 1.0f);
+        buffer.writeSample(1, i, 1.0f);
+    }
+
+    buffer.clearPages(MemoryBuffer::pageSize + 10, 20);
+
+    REQUIRE(buffer.readSample(0, MemoryBuffer::pageSize - 1) == 1.0f);
+    REQUIRE(buffer.readSample(0, MemoryBuffer::pageSize) == 0.0f);
+    REQUIRE(buffer.readSample(1, MemoryBuffer::pageSize * 2 - 1) == 0.0f);
+    REQUIRE(buffer.readSample(1, MemoryBuffer::pageSize * 2) == 1.0f);
+}
+
+TEST_CASE("MemoryBuffer block linear reads match per-sample reads across the wrap", "[buffer]")
+{
+    MemoryBuffer buffer;
+    buffer.prepare(2, 16);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        buffer.writeSample(0, i, static_cast<float>(i));
+        buffer.writeSample(1, i, static_cast<float>(i * i));
+    }
+
+    float block[40];
+    buffer.readLinearBlock(1, 9.25, block, 40);
+    for (int i = 0; i < 40; ++i)
+        REQUIRE(std::abs(block[i] - buffer.readSampleLinear(1, 9.25f + static_cast<float>(i))) < 1.0e-4f);
+
+    buffer.readLinearBlock(0, -2.5, block, 4);
+    REQUIRE(std::abs(block[0] - 13.5f) < 1.0e-5f);
+    REQUIRE(std::abs(block[1] - 14.5f) < 1.0e-5f);
+    REQUIRE(std::abs(block[2] - 7.5f) < 1.0e-5f);
+    REQUIRE(std::abs(block[3] - 0.5f) < 1.0e-5f);
+}
+
+TEST_CASE("MemoryBuffer block writes split at the wrap point", "[buffer]")
+{
+    MemoryBuffer buffer;
+    buffer.prepare(2, 8);
+
+    const float source[] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f };
+    buffer.writeBlock(1, 6, source, 5);
+
+    REQUIRE(buffer.readSample(1, 6) == 1.0f);
+    REQUIRE(buffer.readSample(1, 7) == 2.0f);
+    REQUIRE(buffer.readSample(1, 0) == 3.0f);
+    REQUIRE(buffer.readSample(1, 2) == 5.0f);
+    REQUIRE(buffer.readSample(1, 3) == 0.0f);
+    REQUIRE(buffer.readSample(0, 6) == 0.0f);
+}
+
+TEST_CASE("MemoryBuffer packed formats halve the footprint and quantise writes", "[buffer]")
+{
+    MemoryBuffer floats;
+    floats.prepare(2, 1000);
+    MemoryBuffer words;
+    words.prepare(2, 1000, SampleFormat::Int16);
+
+    REQUIRE(words.isPacked());
+    REQUIRE(words.getMemoryBytes() * 2 == floats.getMemoryBytes());
+    REQUIRE(words.getReadPointer(0) == nullptr);
+    REQUIRE(words.getPackedReadPointer(1) != nullptr);
+
+    const float source[] = { 0.25f, -0.5f, 1.5f, 0.001f };
+    words.writeBlock(1, 998, source, 4);
+    REQUIRE(std::abs(words.readSample(1, 998) - 0.25f) < 1.0f / 32767.0f);
+    REQUIRE(std::abs(words.readSample(1, 999) + 0.5f) < 1.0e-4f);
+    REQUIRE(words.readSample(1, 0) == 1.0f);
+    REQUIRE(std::abs(words.readSample(1, 1) - 0.001f) < 1.0f / 32767.0f);
+
+    float block[3];
+    words.readLinearBlock(1, 998.5, block, 3);
+    REQUIRE(std::abs(block[1] - 0.25f) < 1.0e-4f);
+}
+
+TEST_CASE("MemoryBuffer format changes keep the content", "[buffer]")
+{
+    MemoryBuffer buffer;
+    buffer.prepare(1, 64);
+    for (int i = 0; i < 64; ++i)
+        buffer.writeSample(0, i, std::sin(static_cast<float>(i) * 0.2f) * 0.9f);
+    buffer.setWriteIndex(17);
+
+    buffer.setFormat(SampleFormat::Int12);
+    REQUIRE(buffer.getWriteIndex() == 17);
+    for (int i = 0; i < 64; ++i)
+        REQUIRE(std::abs(buffer.readSample(0, i) - std::sin(static_cast<float>(i) * 0.2f) * 0.9f) <= 0.5f / 2047.0f);
+
+    const auto quantised = buffer.readSample(0, 5);
+    buffer.setFormat(SampleFormat::Float32);
+    REQUIRE_FALSE(buffer.isPacked());
+    REQUIRE(buffer.readSample(0, 5) == quantised);
+}
+
+TEST_CASE("MemoryBuffer block reads match per-sample reads across the wrap", "[buffer]")
+{
+    for (const auto format : { SampleFormat::Float32, SampleFormat::Int16 })
+    {
+        MemoryBuffer buffer;
+        buffer.prepare(2, 100, format);
+        for (int i = 0; i < 100; ++i)
+            buffer.writeSample(1, i, static_cast<float>(i) / 128.0f);
+
+        float block[130];
+        buffer.readBlock(1, 90, block, 130);
+        for (int i = 0; i < 130; ++i)
+            REQUIRE(block[i] == buffer.readSample(1, (90 + i) % 100));
+    }
+}
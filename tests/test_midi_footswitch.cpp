@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "dsp/MidiFootswitch.h"
+
+TEST_CASE("MidiFootswitchMap default controllers trigger on press edge", "[midi]")
+{
+    MidiFootswitchMap map;
+    FootswitchAction action = FootswitchAction::Count;
+
+    const auto playCc = MidiFootswitchMap::defaultFirstController + static_cast<int>(FootswitchAction::Play);
+    REQUIRE(map.handleEvent(FootswitchBinding::Kind::Controller, 1, playCc, 127, action));
+    REQUIRE(action == FootswitchAction::Play);
+
+    REQUIRE_FALSE(map.handleEvent(FootswitchBinding::Kind::Controller, 1, playCc, 127, action));
+    REQUIRE_FALSE(map.handleEvent(FootswitchBinding::Kind::Controller, 1, playCc, 0, action));
+    REQUIRE(map.handleEvent(FootswitchBinding::Kind::Controller, 1, playCc, 100, action));
+}
+
+TEST_CASE("MidiFootswitchMap notes press on note-on only", "[midi]")
+{
+    MidiFootswitchMap map;
+    FootswitchBinding binding;
+    binding.kind = FootswitchBinding::Kind::Note;
+    binding.channel = 2;
+    binding.number = 60;
+    map.setBinding(FootswitchAction::Clear, binding);
+
+    FootswitchAction action = FootswitchAction::Count;
+    REQUIRE_FALSE(map.handleEvent(FootswitchBinding::Kind::Note, 1, 60, 100, action));
+    REQUIRE(map.handleEvent(FootswitchBinding::Kind::Note, 2, 60, 100, action));
+    REQUIRE(action == FootswitchAction::Clear);
+    REQUIRE_FALSE(map.handleEvent(FootswitchBinding::Kind::Note, 2, 60, 0, action));
+}
+
+TEST_CASE("MidiFootswitchMap learn binds the next pressed control", "[midi]")
+{
+    MidiFootswitchMap map;
+    map.beginLearn(FootswitchAction::Reverse);
+    REQUIRE(map.isLearning());
+
+    FootswitchAction action = FootswitchAction::Count;
+    REQUIRE_FALSE(map.handleEvent(FootswitchBinding::Kind::Note, 3, 48, 90, action));
+    REQUIRE_FALSE(map.isLearning());
+
+    const auto learned = map.getBinding(FootswitchAction::Reverse);
+    REQUIRE(learned.kind == FootswitchBinding::Kind::Note);
+    REQUIRE(learned.channel == 3);
+    REQUIRE(learned.number == 48);
+
+    REQUIRE(map.handleEvent(FootswitchBinding::Kind::Note, 3, 48, 90, action));
+    REQUIRE(action == FootswitchAction::Reverse);
+}
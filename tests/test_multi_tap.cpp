@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "dsp/MemoryBuffer.h"
+#include "dsp/MultiTap.h"
+
+namespace
+{
+    MemoryBuffer makeRamp(int channels, int size)
+    {
+        MemoryBuffer buffer;
+        buffer.prepare(channels, size);
+        for (int channel = 0; channel < channels; ++channel)
+            for (int i = 0; i < size; ++i)
+                buffer.writeSample(channel, i, static_cast<float>(i));
+        return buffer;
+    }
+}
+
+TEST_CASE("MultiTap is silent without audible taps", "[multitap]")
+{
+    const auto buffer = makeRamp(1, 64);
+    MultiTap taps;
+    taps.prepare(16);
+    taps.setNumTaps(2);
+    REQUIRE_FALSE(taps.isActive());
+
+    std::vector<float> out(16, 1.0f);
+    std::vector<float> send(16, 1.0f);
+    float* outs[] = { out.data() };
+    float* sends[] = { send.data() };
+    taps.process(buffer, 40, outs, sends, 1, 16);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        REQUIRE(out[static_cast<size_t>(i)] == 0.0f);
+        REQUIRE(send[static_cast<size_t>(i)] == 0.0f);
+    }
+}
+
+TEST_CASE("MultiTap sums taps at their delays once the gain ramp settles", "[multitap]")
+{
+    const auto buffer = makeRamp(1, 64);
+    MultiTap taps;
+    taps.prepare(8);
+    taps.setNumTaps(2);
+    taps.setTap(0, { 10.0f, 1.0f, 0.0f, 0.0f });
+    taps.setTap(1, { 20.5f, 0.5f, 0.0f, 0.25f });
+    REQUIRE(taps.isActive());
+
+    std::vector<float> out(8);
+    std::vector<float> send(8);
+    float* outs[] = { out.data() };
+    float* sends[] = { send.data() };
+    taps.process(buffer, 30, outs, sends, 1, 8);
+    REQUIRE(out[7] == 30.0f + 7.0f - 10.0f + 0.5f * (30.0f + 7.0f - 20.5f));
+
+    taps.process(buffer, 30, outs, sends, 1, 8);
+    for (int i = 0; i < 8; ++i)
+    {
+        const auto expected = (20.0f + static_cast<float>(i)) + 0.5f * (9.5f + static_cast<float>(i));
+        REQUIRE(std::abs(out[static_cast<size_t>(i)] - expected) < 1.0e-4f);
+        REQUIRE(std::abs(send[static_cast<size_t>(i)] - 0.25f * (9.5f + static_cast<float>(i))) < 1.0e-4f);
+    }
+}
+
+TEST_CASE("MultiTap pans a mono sum across stereo outputs", "[multitap]")
+{
+    const auto buffer = makeRamp(2, 64);
+    MultiTap taps;
+    taps.prepare(4);
+    taps.setNumTaps(1);
+    taps.setTap(0, { 8.0f, 1.0f, -1.0f, 0.0f });
+
+    std::vector<float> left(4);
+    std::vector<float> right(4);
+    std::vector<float> sendL(4);
+    std::vector<float> sendR(4);
+    float* outs[] = { left.data(), right.data() };
+    float* sends[] = { sendL.data(), sendR.data() };
+    taps.process(buffer, 16, outs, sends, 2, 4);
+    taps.process(buffer, 16, outs, sends, 2, 4);
+
+    REQUIRE(std::abs(left[0] - 8.0f) < 1.0e-4f);
+    REQUIRE(std::abs(right[0]) < 1.0e-4f);
+}
+
+TEST_CASE("MultiTap hands taps closer than the block to the kernel", "[multitap]")
+{
+    const auto buffer = makeRamp(2, 512);
+    MultiTap taps;
+    taps.prepare(64);
+    taps.setNumTaps(4);
+
+    // Silent taps don't count, however close.
+    taps.setTap(0, { 2.0f, 0.0f, 0.0f, 0.0f });
+    taps.setTap(1, { 100.7f, 1.0f, 0.0f, 0.0f });
+    taps.setTap(2, { 40.25f, 0.0f, 1.0f, 0.5f });
+    taps.setTap(3, { 0.25f, 1.0f, -1.0f, 0.0f });
+    REQUIRE_FALSE(taps.isTapActive(0));
+
+    std::vector<float> left(64);
+    std::vector<float> right(64);
+    std::vector<float> sendL(64);
+    std::vector<float> sendR(64);
+    float* outs[] = { left.data(), right.data() };
+    float* sends[] = { sendL.data(), sendR.data() };
+    taps.process(buffer, 200, outs, sends, 2, 64);
+
+    REQUIRE(taps.getNumNearTaps() == 2);
+    const auto& send = taps.getNearTaps()[0];
+    REQUIRE(send.wholeDelay == 41);
+    REQUIRE(send.fraction == 0.75f);
+    REQUIRE(send.gain == 0.0f);
+    REQUIRE(send.gainStep == 0.0f);
+    REQUIRE(send.send == 0.0f);
+    REQUIRE(std::abs(send.sendStep - 0.5f / 64.0f) < 1.0e-9f);
+    REQUIRE(std::abs(send.scale[0]) < 1.0e-6f);
+    REQUIRE(std::abs(send.scale[1] - 0.5f) < 1.0e-6f);
+
+    // Closer than a sample still reads the last written one.
+    const auto& closest = taps.getNearTaps()[1];
+    REQUIRE(closest.wholeDelay == 1);
+    REQUIRE(closest.fraction == 0.0f);
+    REQUIRE(std::abs(closest.scale[0] - 0.5f) < 1.0e-6f);
+
+    // Only the far tap is in the block output, and none of them sends.
+    const auto expectedLast = 0.5f * (200.0f + 63.0f - 100.7f) * 2.0f * std::cos(0.78539816f);
+    REQUIRE(std::abs(left[63] - expectedLast) < 1.0e-3f);
+    for (int i = 0; i < 64; ++i)
+    {
+        REQUIRE(sendL[static_cast<size_t>(i)] == 0.0f);
+        REQUIRE(sendR[static_cast<size_t>(i)] == 0.0f);
+    }
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "dsp/NoiseSource.h"
+
+TEST_CASE("NoiseSource fills values in [0, 1] deterministically", "[noise]")
+{
+    NoiseSource a;
+    NoiseSource b;
+    a.prepare(2);
+    b.prepare(2);
+    a.reset(42u);
+    b.reset(42u);
+
+    std::vector<float> blockA(512);
+    std::vector<float> blockB(512);
+    a.fill(0, blockA.data(), 512);
+    b.fill(0, blockB.data(), 256);
+    b.fill(0, blockB.data() + 256, 256);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < blockA.size(); ++i)
+    {
+        REQUIRE(blockA[i] >= 0.0f);
+        REQUIRE(blockA[i] <= 1.0f);
+        REQUIRE(blockA[i] == blockB[i]);
+        sum += blockA[i];
+    }
+
+    REQUIRE(std::abs(sum / 512.0 - 0.5) < 0.05);
+}
+
+TEST_CASE("NoiseSource channels are decorrelated at and around lag zero", "[noise]")
+{
+    // A shifted copy of one channel in the other would pass at lag 0 and fail next to it.
+    for (const auto seed : { 0u, 1u, 42u, NoiseSource::defaultSeed, 0xffffffffu })
+    {
+        NoiseSource source;
+        source.prepare(2);
+        source.reset(seed);
+
+        constexpr int count = 8192;
+        constexpr int maxLag = 4;
+        std::vector<float> left(count + 2 * maxLag);
+        std::vector<float> right(count + 2 * maxLag);
+        source.fill(0, left.data(), static_cast<int>(left.size()));
+        source.fill(1, right.data(), static_cast<int>(right.size()));
+
+        for (int lag = -maxLag; lag <= maxLag; ++lag)
+        {
+            double correlation = 0.0;
+            double energy = 0.0;
+            int matches = 0;
+            for (int i = maxLag; i < count + maxLag; ++i)
+            {
+                const auto l = left[static_cast<size_t>(i)];
+                const auto r = right[static_cast<size_t>(i + lag)];
+                correlation += (l - 0.5) * (r - 0.5);
+                energy += (l - 0.5) * (l - 0.5);
+                matches += l == r ? 1 : 0;
+            }
+
+            INFO("seed " << seed << ", lag " << lag);
+            REQUIRE(std::abs(correlation / energy) < 0.05);
+            REQUIRE(matches < 4);
+        }
+    }
+}
@@ -2,6 +2,7 @@
 
 #include <cmath>
 
+#include "dsp/FeedbackModel.h"
 #include "dsp/Overdub.h"
 
 static bool approxEqual(float a, float b, float epsilon = 1.0e-4f)
@@ -30,3 +31,51 @@ TEST_CASE("Overdub apply blends retain + input + feedback", "[overdub]")
 
     REQUIRE(approxEqual(result, expected));
 }
+
+TEST_CASE("Overdub block kernel matches the per-sample chain", "[overdub]")
+{
+    constexpr int numSamples = 32;
+    float loopA[2][8] {};
+    float loopB[2][8] {};
+    float input[2][numSamples];
+    float read[2][numSamples];
+    float noise[2][numSamples];
+    int indices[numSamples];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        indices[i] = (i / 2 + 5) % 8;
+        for (int c = 0; c < 2; ++c)
+        {
+            input[c][i] = std::sin(0.3f * static_cast<float>(i + c));
+            read[c][i] = 0.5f * std::cos(0.2f * static_cast<float>(i));
+            noise[c][i] = static_cast<float>((i * 7 + c * 3) % 10) / 10.0f;
+        }
+    }
+
+    FeedbackModel reference;
+    reference.reset(48000.0);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int c = 0; c < 2; ++c)
+        {
+            auto& cell = loopA[c][indices[i]];
+            const auto written = Overdub::apply(cell, input[c][i], read[c][i], 0.7f, 0.4f, 0.3f);
+            cell = reference.process(c, written, 0.5f, 0.2f, 1.0f, noise[c][i]);
+        }
+    }
+
+    FeedbackModel degrade;
+    degrade.reset(48000.0);
+    degrade.setParameters(0.5f, 0.2f);
+    float* loops[] = { loopB[0], loopB[1] };
+    const float* inputs[] = { input[0], input[1] };
+    const float* reads[] = { read[0], read[1] };
+    const float* noises[] = { noise[0], noise[1] };
+    const auto gains = Overdub::makeGains(0.7f, 0.4f, 0.3f);
+    Overdub::processBlock({ loops, inputs, reads, noises, indices, 2, numSamples }, degrade, gains, gains);
+
+    for (int c = 0; c < 2; ++c)
+        for (int i = 0; i < 8; ++i)
+            REQUIRE(approxEqual(loopA[c][i], loopB[c][i], 1.0e-6f));
+}
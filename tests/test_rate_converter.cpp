@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "dsp/RateConverter.h"
+
+namespace
+{
+    constexpr double kPi = 3.14159265358979323846;
+
+    std::vector<float> makeCycle(int length, double cycles, float amplitude = 0.5f)
+    {
+        std::vector<float> cycle(static_cast<size_t>(length));
+        for (int i = 0; i < length; ++i)
+            cycle[static_cast<size_t>(i)] = amplitude * static_cast<float>(std::sin(2.0 * kPi * cycles * i / length));
+        return cycle;
+    }
+
+    float peak(const std::vector<float>& samples)
+    {
+        float value = 0.0f;
+        for (auto sample : samples)
+            value = std::max(value, std::abs(sample));
+        return value;
+    }
+}
+
+TEST_CASE("RateConverter widens the kernel as the cutoff drops", "[rateconverter]")
+{
+    RateConverter converter;
+    converter.prepare(2.0);
+    const auto upTaps = converter.getNumTaps();
+    converter.prepare(44100.0 / 96000.0);
+
+    REQUIRE(converter.getRatio() == 44100.0 / 96000.0);
+    REQUIRE(converter.getNumTaps() > upTaps);
+    REQUIRE(converter.getNumTaps() <= RateConverter::maxTaps);
+}
+
+TEST_CASE("RateConverter keeps DC and in-band tones", "[rateconverter]")
+{
+    RateConverter converter;
+    converter.prepare(96000.0 / 44100.0);
+
+    std::vector<float> dc(441, 0.25f);
+    std::vector<float> out(960);
+    converter.process(dc.data(), static_cast<int>(dc.size()), out.data(), static_cast<int>(out.size()));
+    for (auto sample : out)
+        REQUIRE(std::abs(sample - 0.25f) < 1.0e-4f);
+
+    // 10 cycles over the region stay 10 cycles, wrapping cleanly at the cycle end.
+    const auto tone = makeCycle(441, 10.0);
+    converter.process(tone.data(), static_cast<int>(tone.size()), out.data(), static_cast<int>(out.size()));
+    const auto expected = makeCycle(960, 10.0);
+    for (size_t i = 0; i < out.size(); ++i)
+        REQUIRE(std::abs(out[i] - expected[i]) < 1.0e-3f);
+}
+
+TEST_CASE("RateConverter removes content above the new Nyquist when downsampling", "[rateconverter]")
+{
+    RateConverter converter;
+    converter.prepare(0.5);
+
+    // 0.8 of the input Nyquist would fold back to 0.4 of the output band.
+    const auto high = makeCycle(1000, 400.0);
+    std::vector<float> out(500);
+    converter.process(high.data(), static_cast<int>(high.size()), out.data(), static_cast<int>(out.size()));
+    REQUIRE(peak(out) < 0.5f * 1.0e-3f);
+
+    const auto low = makeCycle(1000, 125.0);
+    converter.process(low.data(), static_cast<int>(low.size()), out.data(), static_cast<int>(out.size()));
+    REQUIRE(std::abs(peak(out) - 0.5f) < 5.0e-3f);
+}
+
+TEST_CASE("RateConverter renders a cycle piecewise exactly as in one pass", "[rateconverter]")
+{
+    const auto cycle = makeCycle(1000, 7.0);
+    RateConverter converter;
+    converter.prepare(1.47);
+
+    std::vector<float> whole(1470);
+    converter.process(cycle.data(), 1000, whole.data(), 1470);
+
+    std::vector<float> piece(400);
+    for (int start = 0; start < 1470; start += 400)
+    {
+        const auto count = std::min(400, 1470 - start);
+        converter.process(cycle.data(), 1000, piece.data(), 1470, start, count);
+        for (int i = 0; i < count; ++i)
+            REQUIRE(piece[static_cast<size_t>(i)] == whole[static_cast<size_t>(start + i)]);
+    }
+}
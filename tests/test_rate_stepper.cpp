@@ -51,3 +51,64 @@ TEST_CASE("RateStepper wraps buffer size", "[rate]")
     stepper.advance();
     REQUIRE(stepper.getIndex(10) == 0);
 }
+
+TEST_CASE("RateStepper wraps in fixed point with a loop length", "[rate]")
+{
+    RateStepper stepper;
+    stepper.setLength(10);
+    stepper.reset(8.5);
+    stepper.setRate(1.25);
+
+    stepper.advance();
+    REQUIRE(stepper.getIndex(10) == 9);
+    REQUIRE(stepper.getFraction() == 0.75f);
+    stepper.advance();
+    REQUIRE(stepper.getIndex(10) == 1);
+
+    stepper.setRate(-3.0);
+    stepper.advance();
+    REQUIRE(stepper.getIndex(10) == 8);
+}
+
+TEST_CASE("RateStepper block fill matches per-sample stepping", "[rate]")
+{
+    RateStepper block;
+    RateStepper single;
+    block.setLength(37);
+    single.setLength(37);
+    block.setRate(-0.7);
+    single.setRate(-0.7);
+
+    int indices[64];
+    float fractions[64];
+    block.fillBlock(indices, fractions, 64);
+
+    for (int i = 0; i < 64; ++i)
+    {
+        REQUIRE(indices[i] == single.getIndex(37));
+        REQUIRE(fractions[i] == single.getFraction());
+        single.advance();
+    }
+
+    REQUIRE(block.getPosition() == single.getPosition());
+}
+
+TEST_CASE("RateStepper smoothed rate ramps to the target", "[rate]")
+{
+    RateStepper stepper;
+    stepper.setLength(1000);
+    stepper.setRate(1.0);
+    stepper.setRateSmoothed(2.0, 100);
+
+    double previous = stepper.getRate();
+    for (int i = 0; i < 99; ++i)
+    {
+        stepper.advance();
+        REQUIRE(stepper.getRate() >= previous);
+        REQUIRE(stepper.getRate() < 2.0);
+        previous = stepper.getRate();
+    }
+
+    stepper.advance();
+    REQUIRE(stepper.getRate() == 2.0);
+}
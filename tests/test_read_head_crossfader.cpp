@@ -0,0 +1,48 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "dsp/ReadHeadCrossfader.h"
+
+TEST_CASE("ReadHeadCrossfader ramps the new head from 0 to 1", "[crossfade]")
+{
+    ReadHeadCrossfader fader;
+    REQUIRE_FALSE(fader.isActive());
+
+    RateStepper previous;
+    previous.setLength(100);
+    previous.reset(40.0);
+    fader.begin(previous, 7, 64);
+    REQUIRE(fader.isActive());
+    REQUIRE(fader.getPreviousOffset() == 7);
+    REQUIRE(fader.getPreviousHead().getIndex(100) == 40);
+
+    std::vector<float> gains(100);
+    fader.fillGains(gains.data(), 100);
+
+    REQUIRE(gains[0] > 0.0f);
+    REQUIRE(gains[0] < 0.01f);
+    for (int i = 1; i < 64; ++i)
+        REQUIRE(gains[static_cast<size_t>(i)] >= gains[static_cast<size_t>(i - 1)]);
+    REQUIRE(gains[63] == 1.0f);
+    REQUIRE(gains[99] == 1.0f);
+    REQUIRE_FALSE(fader.isActive());
+}
+
+TEST_CASE("ReadHeadCrossfader previous head keeps stepping on its own", "[crossfade]")
+{
+    ReadHeadCrossfader fader;
+    RateStepper previous;
+    previous.setLength(10);
+    previous.reset(8.0);
+    previous.setRate(-1.0);
+    fader.begin(previous, 0, 16);
+
+    previous.advance();
+
+    int indices[4];
+    fader.getPreviousHead().fillBlock(indices, nullptr, 4);
+    REQUIRE(indices[0] == 8);
+    REQUIRE(indices[1] == 7);
+    REQUIRE(indices[3] == 5);
+}
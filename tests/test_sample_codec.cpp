@@ -0,0 +1,55 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "dsp/SampleCodec.h"
+
+TEST_CASE("SampleCodec round trips within half a step", "[codec]")
+{
+    const auto int16 = SampleCodec::forFormat(SampleFormat::Int16);
+    const auto int12 = SampleCodec::forFormat(SampleFormat::Int12);
+
+    for (int i = -100; i <= 100; ++i)
+    {
+        const auto value = static_cast<float>(i) * 0.00997f;
+        REQUIRE(std::abs(int16.unpack(int16.pack(value)) - value) <= 0.5f / 32767.0f + 1.0e-7f);
+        REQUIRE(std::abs(int12.unpack(int12.pack(value)) - value) <= 0.5f / 2047.0f + 1.0e-7f);
+    }
+}
+
+TEST_CASE("SampleCodec 12-bit words leave the low bits clear", "[codec]")
+{
+    const auto int12 = SampleCodec::forFormat(SampleFormat::Int12);
+    for (int i = -50; i <= 50; ++i)
+        REQUIRE((int12.pack(static_cast<float>(i) * 0.0193f) & 0xF) == 0);
+}
+
+TEST_CASE("SampleCodec clips at full scale", "[codec]")
+{
+    const auto int16 = SampleCodec::forFormat(SampleFormat::Int16);
+    REQUIRE(int16.pack(1.7f) == 32767);
+    REQUIRE(int16.pack(-3.0f) == -32767);
+    REQUIRE(int16.unpack(int16.pack(1.7f)) == 1.0f);
+    REQUIRE(int16.pack(0.0f) == 0);
+}
+
+TEST_CASE("SampleCodec block conversions match per-sample conversions", "[codec]")
+{
+    const auto int12 = SampleCodec::forFormat(SampleFormat::Int12);
+    std::vector<float> source(37);
+    for (size_t i = 0; i < source.size(); ++i)
+        source[i] = std::sin(static_cast<float>(i) * 0.4f) * 1.2f;
+
+    std::vector<std::int16_t> words(source.size());
+    std::vector<float> restored(source.size());
+    int12.packBlock(source.data(), words.data(), static_cast<int>(source.size()));
+    int12.unpackBlock(words.data(), restored.data(), static_cast<int>(source.size()));
+
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        REQUIRE(words[i] == int12.pack(source[i]));
+        REQUIRE(restored[i] == int12.unpack(words[i]));
+    }
+}
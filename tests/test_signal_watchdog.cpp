@@ -0,0 +1,53 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <vector>
+
+#include "dsp/SignalWatchdog.h"
+
+TEST_CASE("SignalWatchdog classifies NaN, Inf and denormals", "[watchdog]")
+{
+    std::vector<float> data(64, 0.25f);
+    data[3] = std::numeric_limits<float>::quiet_NaN();
+    data[10] = std::numeric_limits<float>::infinity();
+    data[11] = -std::numeric_limits<float>::infinity();
+    data[40] = std::numeric_limits<float>::denorm_min();
+
+    const auto result = SignalWatchdog::scan(data.data(), static_cast<int>(data.size()));
+    REQUIRE(result.nanCount == 1);
+    REQUIRE(result.infCount == 2);
+    REQUIRE(result.denormalCount == 1);
+    REQUIRE(result.hasNonFinite());
+}
+
+TEST_CASE("SignalWatchdog scans circular spans across the wrap", "[watchdog]")
+{
+    std::vector<float> data(16, 0.0f);
+    data[15] = std::numeric_limits<float>::quiet_NaN();
+    data[1] = std::numeric_limits<float>::quiet_NaN();
+    data[8] = std::numeric_limits<float>::quiet_NaN();
+
+    REQUIRE(SignalWatchdog::scanCircular(data.data(), 16, 14, 4).nanCount == 2);
+    REQUIRE(SignalWatchdog::scanCircular(data.data(), 16, -2, 3).nanCount == 1);
+}
+
+TEST_CASE("SignalWatchdog counters accumulate and sanitize zeroes faults", "[watchdog]")
+{
+    SignalWatchdog watchdog;
+    std::vector<float> data { 0.5f, std::numeric_limits<float>::quiet_NaN(), -0.5f,
+                              std::numeric_limits<float>::infinity() };
+
+    watchdog.report(SignalWatchdog::scan(data.data(), 4));
+    watchdog.report(SignalWatchdog::scan(data.data(), 4));
+    REQUIRE(watchdog.getNanCount() == 2);
+    REQUIRE(watchdog.getInfCount() == 2);
+
+    REQUIRE(SignalWatchdog::sanitize(data.data(), 4) == 2);
+    REQUIRE(data[0] == 0.5f);
+    REQUIRE(data[1] == 0.0f);
+    REQUIRE(data[3] == 0.0f);
+    REQUIRE_FALSE(SignalWatchdog::scan(data.data(), 4).hasEvents());
+
+    watchdog.resetCounters();
+    REQUIRE(watchdog.getNanCount() == 0);
+}
@@ -1,5 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "dsp/Smoother.h"
 
 TEST_CASE("Smoother approaches target without overshoot", "[smoother]")
@@ -17,3 +21,107 @@ TEST_CASE("Smoother approaches target without overshoot", "[smoother]")
         previous = value;
     }
 }
+
+TEST_CASE("Smoother block form matches the per-sample form for every shape", "[smoother]")
+{
+    for (const auto shape : { Smoother::Shape::Exponential, Smoother::Shape::Linear, Smoother::Shape::Stepped })
+    {
+        Smoother block;
+        Smoother single;
+        for (auto* smoother : { &block, &single })
+        {
+            smoother->reset(48000.0, 100.0f, 10.0f);
+            smoother->setStepMs(1.0f);
+            smoother->setShape(shape);
+            smoother->setTarget(-250.0f);
+        }
+
+        // Uneven block sizes, with a retarget halfway through.
+        std::vector<float> values(173);
+        for (int pass = 0; pass < 60; ++pass)
+        {
+            if (pass == 3)
+            {
+                block.setTarget(40.0f);
+                single.setTarget(40.0f);
+            }
+
+            block.process(values.data(), static_cast<int>(values.size()));
+            for (const auto value : values)
+                REQUIRE(value == single.process());
+            REQUIRE(block.getCurrent() == single.getCurrent());
+            REQUIRE(block.isSettled() == single.isSettled());
+        }
+
+        REQUIRE(block.isSettled());
+        REQUIRE(block.getCurrent() == 40.0f);
+    }
+}
+
+TEST_CASE("Smoother linear ramp reaches the target after the ramp time", "[smoother]")
+{
+    Smoother smoother;
+    smoother.reset(48000.0, 0.0f, 10.0f);
+    smoother.setShape(Smoother::Shape::Linear);
+    smoother.setTarget(480.0f);
+    REQUIRE_FALSE(smoother.isSettled());
+
+    std::vector<float> values(1000);
+    smoother.process(values.data(), static_cast<int>(values.size()));
+    for (size_t i = 0; i < 480; ++i)
+        REQUIRE(std::abs(values[i] - static_cast<float>(i + 1)) < 1.0e-3f);
+    REQUIRE(values[479] == 480.0f);
+    REQUIRE(values[999] == 480.0f);
+    REQUIRE(smoother.isSettled());
+
+    // Setting the same target again does not restart anything.
+    smoother.setTarget(480.0f);
+    REQUIRE(smoother.isSettled());
+}
+
+TEST_CASE("Smoother stepped shape holds each step for the step time", "[smoother]")
+{
+    Smoother smoother;
+    smoother.reset(48000.0, 0.0f, 10.0f);
+    smoother.setStepMs(2.5f);
+    smoother.setShape(Smoother::Shape::Stepped);
+    smoother.setTarget(400.0f);
+
+    // 480 samples in four held steps of 120.
+    std::vector<float> values(600);
+    smoother.process(values.data(), static_cast<int>(values.size()));
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        const auto step = std::min<size_t>((i + 1) / 120, 4);
+        REQUIRE(std::abs(values[i] - 100.0f * static_cast<float>(step)) < 1.0e-3f);
+    }
+    REQUIRE(values[479] == 400.0f);
+    REQUIRE(smoother.isSettled());
+}
+
+TEST_CASE("Smoother exponential shape settles exactly in a known number of samples", "[smoother]")
+{
+    Smoother smoother;
+    smoother.reset(48000.0, 0.0f, 10.0f);
+    smoother.setTarget(1000.0f);
+
+    std::vector<float> values(48000, -1.0f);
+    smoother.process(values.data(), static_cast<int>(values.size()));
+    REQUIRE(smoother.isSettled());
+
+    // One time constant in: 1 - 1/e of the way.
+    REQUIRE(std::abs(values[479] - 1000.0f * (1.0f - std::exp(-1.0f))) < 0.5f);
+
+    const auto settledAt = static_cast<size_t>(std::find(values.begin(), values.end(), 1000.0f) - values.begin());
+    REQUIRE(settledAt < 10000);
+    for (size_t i = settledAt; i < values.size(); ++i)
+        REQUIRE(values[i] == 1000.0f);
+    for (size_t i = 1; i < settledAt; ++i)
+        REQUIRE(values[i] >= values[i - 1]);
+
+    // A zero time jumps on the next sample.
+    smoother.setTimeMs(0.0f);
+    smoother.setTarget(5.0f);
+    REQUIRE(smoother.process() == 5.0f);
+    REQUIRE(smoother.isSettled());
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/StateVariableFilter.h"
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr double kPi = 3.14159265358979323846;
+
+    // Steady-state peak gain for a sine at frequencyHz through lane 0.
+    float measureGain(StateVariableFilter::Mode mode, float cutoffHz, float resonance, float frequencyHz)
+    {
+        StateVariableFilter filter;
+        filter.prepare(kSampleRate);
+        filter.setTarget(cutoffHz, resonance, mode);
+        filter.updateCoefficients(0);
+
+        float peak = 0.0f;
+        for (int i = 0; i < 48000; ++i)
+        {
+            const auto input = static_cast<float>(std::sin(2.0 * kPi * frequencyHz * i / kSampleRate));
+            const auto output = filter.processSample(0, input);
+            if (i >= 24000)
+                peak = std::max(peak, std::abs(output));
+        }
+
+        return peak;
+    }
+}
+
+TEST_CASE("StateVariableFilter responses at and around the cutoff", "[svf]")
+{
+    using Mode = StateVariableFilter::Mode;
+
+    // Butterworth at zero resonance: -3 dB at the cutoff for lowpass and highpass.
+    REQUIRE(std::abs(measureGain(Mode::Lowpass, 1000.0f, 0.0f, 1000.0f) - 0.7071f) < 0.01f);
+    REQUIRE(std::abs(measureGain(Mode::Highpass, 1000.0f, 0.0f, 1000.0f) - 0.7071f) < 0.01f);
+    REQUIRE(std::abs(measureGain(Mode::Bandpass, 1000.0f, 0.0f, 1000.0f) - 1.0f) < 0.01f);
+
+    REQUIRE(measureGain(Mode::Lowpass, 1000.0f, 0.0f, 50.0f) > 0.99f);
+    REQUIRE(measureGain(Mode::Lowpass, 1000.0f, 0.0f, 10000.0f) < 0.02f);
+    REQUIRE(measureGain(Mode::Highpass, 1000.0f, 0.0f, 50.0f) < 0.01f);
+    REQUIRE(measureGain(Mode::Highpass, 1000.0f, 0.0f, 10000.0f) > 0.98f);
+    REQUIRE(measureGain(Mode::Bandpass, 1000.0f, 0.0f, 50.0f) < 0.1f);
+
+    // Full resonance peaks at Q (about 10) in the lowpass, while the bandpass stays at unity.
+    REQUIRE(measureGain(Mode::Lowpass, 1000.0f, 1.0f, 1000.0f) > 9.0f);
+    REQUIRE(std::abs(measureGain(Mode::Bandpass, 1000.0f, 1.0f, 1000.0f) - 1.0f) < 0.02f);
+}
+
+TEST_CASE("StateVariableFilter frame form matches each lane on its own", "[svf]")
+{
+    StateVariableFilter packed;
+    packed.prepare(kSampleRate);
+    packed.setTarget(2500.0f, 0.6f, StateVariableFilter::Mode::Bandpass);
+    packed.updateCoefficients(0);
+
+    StateVariableFilter scalar;
+    scalar.prepare(kSampleRate);
+    scalar.setTarget(2500.0f, 0.6f, StateVariableFilter::Mode::Bandpass);
+    scalar.updateCoefficients(0);
+
+    for (int i = 0; i < 1024; ++i)
+    {
+        StateVariableFilter::Frame frame {};
+        for (int lane = 0; lane < StateVariableFilter::numLanes; ++lane)
+            frame[static_cast<size_t>(lane)] = std::sin(0.05f * static_cast<float>(i * (lane + 1)) + static_cast<float>(lane));
+
+        StateVariableFilter::Frame expected {};
+        for (int lane = 0; lane < StateVariableFilter::numLanes; ++lane)
+            expected[static_cast<size_t>(lane)] = scalar.processSample(lane, frame[static_cast<size_t>(lane)]);
+
+        packed.processFrame(frame);
+        REQUIRE(frame == expected);
+    }
+}
+
+TEST_CASE("StateVariableFilter keeps every lane's state apart", "[svf]")
+{
+    StateVariableFilter filter;
+    filter.prepare(kSampleRate);
+    filter.setTarget(800.0f, 0.9f, StateVariableFilter::Mode::Lowpass);
+    filter.updateCoefficients(0);
+
+    for (int i = 0; i < 256; ++i)
+    {
+        StateVariableFilter::Frame frame { i == 0 ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f };
+        filter.processFrame(frame);
+        REQUIRE(frame[1] == 0.0f);
+        REQUIRE(frame[2] == 0.0f);
+        REQUIRE(frame[3] == 0.0f);
+    }
+}
+
+TEST_CASE("StateVariableFilter glides the cutoff at block rate", "[svf]")
+{
+    StateVariableFilter filter;
+    filter.prepare(kSampleRate);
+
+    // The first update after prepare jumps.
+    filter.setTarget(1000.0f, 0.0f, StateVariableFilter::Mode::Lowpass);
+    filter.updateCoefficients(256);
+    REQUIRE(filter.getCutoff() == 1000.0f);
+    REQUIRE(filter.isSettled());
+
+    // Later ones move part of the way per block, in octaves, and settle within a few time constants.
+    filter.setTarget(4000.0f, 1.0f, StateVariableFilter::Mode::Lowpass);
+    filter.updateCoefficients(240);
+    const auto afterOneBlock = filter.getCutoff();
+    REQUIRE(afterOneBlock > 1000.0f);
+    REQUIRE(afterOneBlock < 4000.0f);
+    REQUIRE(std::abs(std::log2(afterOneBlock / 1000.0f) - 2.0f * (1.0f - std::exp(-0.5f))) < 1.0e-3f);
+    REQUIRE(filter.getResonance() > 0.0f);
+    REQUIRE_FALSE(filter.isSettled());
+
+    for (int block = 0; block < 40 && !filter.isSettled(); ++block)
+        filter.updateCoefficients(240);
+    REQUIRE(filter.isSettled());
+    REQUIRE(filter.getCutoff() == 4000.0f);
+    REQUIRE(filter.getResonance() == 1.0f);
+
+    // A zero-length update jumps.
+    filter.setTarget(500.0f, 0.0f, StateVariableFilter::Mode::Highpass);
+    filter.updateCoefficients(0);
+    REQUIRE(filter.getCutoff() == 500.0f);
+}
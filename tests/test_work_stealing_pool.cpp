@@ -0,0 +1,49 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "cli/WorkStealingPool.h"
+
+TEST_CASE("WorkStealingPool runs every submitted task", "[pool]")
+{
+    std::atomic<int> sum { 0 };
+
+    {
+        WorkStealingPool pool(4);
+        for (int i = 1; i <= 200; ++i)
+            pool.submit([&sum, i] { sum.fetch_add(i); });
+
+        pool.wait();
+        REQUIRE(sum.load() == 200 * 201 / 2);
+
+        pool.submit([&sum] { sum.fetch_add(1); });
+    }
+
+    REQUIRE(sum.load() == 200 * 201 / 2 + 1);
+}
+
+TEST_CASE("WorkStealingPool steals queued work from a busy worker", "[pool]")
+{
+    constexpr int numTasks = 9;
+    std::atomic<int> finished { 0 };
+    std::atomic<bool> sawAll { false };
+
+    WorkStealingPool pool(2);
+    // The first task occupies one worker until every other task has run. Round-robin leaves some
+    // of them queued behind it, so they can only finish if the other worker steals them.
+    pool.submit([&]
+                {
+                    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+                    while (finished.load() < numTasks && std::chrono::steady_clock::now() < deadline)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    sawAll.store(finished.load() == numTasks);
+                });
+
+    for (int i = 0; i < numTasks; ++i)
+        pool.submit([&] { finished.fetch_add(1); });
+
+    pool.wait();
+    REQUIRE(sawAll.load());
+}